@@ -0,0 +1,401 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <string.h>
+#include <immintrin.h>
+#include <stdint.h>
+#include <unistd.h>
+
+// --- CONFIGURAÇÕES ---
+#define MAX_LEVELS 3        // L1, L2, L3
+#define MAX_WAYS 32         // Associatividade máxima suportada
+#define LINE_SIZE 64        // Bytes por linha de cache
+#define N_PADRAO 1024       // Tamanho padrão da matriz
+#define NUM_RUNS 3          // Execuções para a medição real
+
+// --- UTILITÁRIOS DE TEMPO (Alta Precisão) ---
+double get_time_sec() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// --- ALOCAÇÃO E INICIALIZAÇÃO ---
+double* alloc_matrix(int n, const char* name) {
+    double* ptr = (double*)_mm_malloc(n * n * sizeof(double), 64);
+    if (!ptr) {
+        printf("[ERRO] Falha ao alocar %s\n", name);
+        exit(1);
+    }
+
+    for (int i = 0; i < n * n; i++) {
+        ptr[i] = (double)((i % 100) + 1) * 0.01;
+    }
+    return ptr;
+}
+
+void clean_matrix(double* C, int n) {
+    memset(C, 0, n * n * sizeof(double));
+}
+
+// ============================================================
+// --- SIMULADOR DE CACHE (set-associativo, LRU, multinível) ---
+// ============================================================
+// Cada conjunto guarda as tags em ordem de uso (posição 0 = MRU), então um
+// acerto na linha mais recente custa uma comparação. Falha em um nível
+// consulta o seguinte e a linha é instalada em todos os níveis por onde
+// passou (write-allocate, stores tratados como loads, sem invalidação
+// reversa entre níveis).
+typedef struct {
+    size_t size;        // Bytes
+    int ways;
+    size_t sets;
+    int pow2;           // sets é potência de 2 (índice por máscara)
+    uint64_t* tags;     // [sets][ways], UINT64_MAX = inválida
+    uint64_t accesses;
+    uint64_t misses;
+} CacheLevel;
+
+typedef struct {
+    int num_levels;
+    CacheLevel level[MAX_LEVELS];
+} CacheSim;
+
+static void level_init(CacheLevel* c, size_t size, int ways) {
+    if (ways > MAX_WAYS) ways = MAX_WAYS;
+    c->size = size;
+    c->ways = ways;
+    c->sets = size / LINE_SIZE / ways;
+    if (c->sets == 0) c->sets = 1;
+    c->pow2 = (c->sets & (c->sets - 1)) == 0;
+    c->tags = (uint64_t*)malloc(c->sets * ways * sizeof(uint64_t));
+    if (!c->tags) {
+        printf("[ERRO] Falha ao alocar simulador de cache\n");
+        exit(1);
+    }
+    memset(c->tags, 0xFF, c->sets * ways * sizeof(uint64_t));
+    c->accesses = 0;
+    c->misses = 0;
+}
+
+void sim_reset(CacheSim* sim) {
+    for (int l = 0; l < sim->num_levels; l++) {
+        CacheLevel* c = &sim->level[l];
+        memset(c->tags, 0xFF, c->sets * c->ways * sizeof(uint64_t));
+        c->accesses = 0;
+        c->misses = 0;
+    }
+}
+
+// Retorna 1 em acerto; em falha instala a linha como MRU
+static inline int level_access(CacheLevel* c, uint64_t line) {
+    size_t set = c->pow2 ? (line & (c->sets - 1)) : (line % c->sets);
+    uint64_t* way = &c->tags[set * c->ways];
+    c->accesses++;
+
+    if (way[0] == line) return 1;
+    for (int w = 1; w < c->ways; w++) {
+        if (way[w] == line) {
+            memmove(&way[1], &way[0], w * sizeof(uint64_t));
+            way[0] = line;
+            return 1;
+        }
+    }
+    c->misses++;
+    memmove(&way[1], &way[0], (c->ways - 1) * sizeof(uint64_t));
+    way[0] = line;
+    return 0;
+}
+
+static inline void sim_access(CacheSim* sim, const void* addr) {
+    uint64_t line = (uint64_t)(uintptr_t)addr / LINE_SIZE;
+    for (int l = 0; l < sim->num_levels; l++) {
+        if (level_access(&sim->level[l], line)) return;
+    }
+}
+
+// Lê a hierarquia de /sys (caches de dados/unificadas da CPU 0)
+static int read_sys_cache(int index, int* level, size_t* size, int* ways, char* type) {
+    char path[128], buf[64];
+    FILE* fp;
+
+    snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index%d/level", index);
+    if (!(fp = fopen(path, "r"))) return 0;
+    if (!fgets(buf, sizeof(buf), fp)) { fclose(fp); return 0; }
+    fclose(fp);
+    *level = atoi(buf);
+
+    snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index%d/type", index);
+    if (!(fp = fopen(path, "r"))) return 0;
+    if (!fgets(buf, sizeof(buf), fp)) { fclose(fp); return 0; }
+    fclose(fp);
+    sscanf(buf, "%15s", type);
+
+    snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index%d/size", index);
+    if (!(fp = fopen(path, "r"))) return 0;
+    if (!fgets(buf, sizeof(buf), fp)) { fclose(fp); return 0; }
+    fclose(fp);
+    *size = (size_t)atol(buf) * (strchr(buf, 'M') ? 1024 * 1024 : 1024);
+
+    snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index%d/ways_of_associativity", index);
+    if (!(fp = fopen(path, "r"))) return 0;
+    if (!fgets(buf, sizeof(buf), fp)) { fclose(fp); return 0; }
+    fclose(fp);
+    *ways = atoi(buf);
+    return 1;
+}
+
+void sim_init(CacheSim* sim) {
+    // Padrão caso /sys não exista: 32K/8, 1M/16, 32M/16
+    size_t sizes[MAX_LEVELS] = {32 * 1024, 1024 * 1024, 32 * 1024 * 1024};
+    int ways[MAX_LEVELS] = {8, 16, 16};
+    sim->num_levels = MAX_LEVELS;
+
+    for (int idx = 0; idx < 8; idx++) {
+        int level, w;
+        size_t size;
+        char type[16];
+        if (!read_sys_cache(idx, &level, &size, &w, type)) continue;
+        if (strncmp(type, "Instruction", 11) == 0) continue;
+        if (level >= 1 && level <= MAX_LEVELS && w > 0) {
+            sizes[level - 1] = size;
+            ways[level - 1] = w;
+        }
+    }
+
+    // Sobrescrita por variáveis de ambiente: CACHE_L1=48K:12 etc.
+    const char* env[MAX_LEVELS] = {"CACHE_L1", "CACHE_L2", "CACHE_L3"};
+    for (int l = 0; l < MAX_LEVELS; l++) {
+        const char* v = getenv(env[l]);
+        if (v) {
+            size_t kb = (size_t)atol(v);
+            const char* colon = strchr(v, ':');
+            sizes[l] = kb * 1024;
+            if (colon) ways[l] = atoi(colon + 1);
+        }
+        level_init(&sim->level[l], sizes[l], ways[l]);
+    }
+}
+
+// ============================================================
+// --- KERNELS (versão real e versão instrumentada) ---
+// ============================================================
+// O mesmo corpo serve às duas: com sim == NULL o compilador remove o
+// rastreamento (always_inline + constante), com sim != NULL cada acesso a
+// memória gera um endereço para o simulador. Acessos são registrados com a
+// granularidade de 32 bytes do código vetorizado (o naive é vetorizado
+// pelo -O3); como as linhas tocadas e sua ordem não mudam, as falhas são
+// as mesmas de um rastro por elemento.
+#define TRACE(p) do { if (sim) sim_access(sim, (p)); } while (0)
+
+static inline __attribute__((always_inline))
+void naive_body(int n, double* A, double* B, double* C, CacheSim* sim) {
+    for (int i = 0; i < n; i++) {
+        for (int k = 0; k < n; k++) {
+            TRACE(&A[i * n + k]);
+            double r = A[i * n + k];
+            for (int j = 0; j < n; j++) {
+                if ((j & 3) == 0) {
+                    TRACE(&C[i * n + j]);
+                    TRACE(&B[k * n + j]);
+                }
+                C[i * n + j] += r * B[k * n + j];
+            }
+        }
+    }
+}
+
+// loadu/storeu: n vem da linha de comando e nem sempre é múltiplo de 4
+static inline __attribute__((always_inline))
+void avx_body(int n, double* A, double* B, double* C, CacheSim* sim) {
+    for (int i = 0; i < n; i++) {
+        for (int k = 0; k < n; k++) {
+            TRACE(&A[i * n + k]);
+            __m256d a_vec = _mm256_set1_pd(A[i * n + k]);
+            int j = 0;
+            for (; j <= n - 4; j += 4) {
+                TRACE(&C[i * n + j]);
+                TRACE(&B[k * n + j]);
+                __m256d c_vec = _mm256_loadu_pd(&C[i * n + j]);
+                __m256d b_vec = _mm256_loadu_pd(&B[k * n + j]);
+                c_vec = _mm256_add_pd(c_vec, _mm256_mul_pd(a_vec, b_vec));
+                _mm256_storeu_pd(&C[i * n + j], c_vec);
+            }
+            for (; j < n; j++) {
+                TRACE(&C[i * n + j]);
+                TRACE(&B[k * n + j]);
+                C[i * n + j] += A[i * n + k] * B[k * n + j];
+            }
+        }
+    }
+}
+
+// dgemm_avx_block com BLOCK_SIZE em tempo de execução (bs) para a varredura
+static inline __attribute__((always_inline))
+void avx_block_body(int n, double* A, double* B, double* C, int bs, CacheSim* sim) {
+    for (int i_blk = 0; i_blk < n; i_blk += bs) {
+        for (int k_blk = 0; k_blk < n; k_blk += bs) {
+            for (int j_blk = 0; j_blk < n; j_blk += bs) {
+
+                int i_max = (i_blk + bs > n) ? n : i_blk + bs;
+                int k_max = (k_blk + bs > n) ? n : k_blk + bs;
+                int j_max = (j_blk + bs > n) ? n : j_blk + bs;
+
+                for (int i = i_blk; i < i_max; i++) {
+                    for (int k = k_blk; k < k_max; k++) {
+                        TRACE(&A[i * n + k]);
+                        __m256d a_vec = _mm256_set1_pd(A[i * n + k]);
+
+                        int j = j_blk;
+                        #ifdef __FMA__
+                        for (; j <= j_max - 8; j += 8) {
+                            TRACE(&C[i * n + j]);
+                            TRACE(&B[k * n + j]);
+                            TRACE(&C[i * n + j + 4]);
+                            TRACE(&B[k * n + j + 4]);
+                            __m256d c_vec1 = _mm256_loadu_pd(&C[i * n + j]);
+                            __m256d b_vec1 = _mm256_loadu_pd(&B[k * n + j]);
+                            c_vec1 = _mm256_fmadd_pd(a_vec, b_vec1, c_vec1);
+                            _mm256_storeu_pd(&C[i * n + j], c_vec1);
+
+                            __m256d c_vec2 = _mm256_loadu_pd(&C[i * n + j + 4]);
+                            __m256d b_vec2 = _mm256_loadu_pd(&B[k * n + j + 4]);
+                            c_vec2 = _mm256_fmadd_pd(a_vec, b_vec2, c_vec2);
+                            _mm256_storeu_pd(&C[i * n + j + 4], c_vec2);
+                        }
+                        #endif
+
+                        for (; j <= j_max - 4; j += 4) {
+                            TRACE(&C[i * n + j]);
+                            TRACE(&B[k * n + j]);
+                            __m256d c_vec = _mm256_loadu_pd(&C[i * n + j]);
+                            __m256d b_vec = _mm256_loadu_pd(&B[k * n + j]);
+                            #ifdef __FMA__
+                            c_vec = _mm256_fmadd_pd(a_vec, b_vec, c_vec);
+                            #else
+                            c_vec = _mm256_add_pd(c_vec, _mm256_mul_pd(a_vec, b_vec));
+                            #endif
+                            _mm256_storeu_pd(&C[i * n + j], c_vec);
+                        }
+
+                        for (; j < j_max; j++) {
+                            TRACE(&C[i * n + j]);
+                            TRACE(&B[k * n + j]);
+                            C[i * n + j] += A[i * n + k] * B[k * n + j];
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Versões reais (sem rastreamento) e instrumentadas
+void dgemm_naive(int n, double* A, double* B, double* C, int bs) {
+    (void)bs; naive_body(n, A, B, C, NULL);
+}
+void dgemm_avx(int n, double* A, double* B, double* C, int bs) {
+    (void)bs; avx_body(n, A, B, C, NULL);
+}
+void dgemm_avx_block(int n, double* A, double* B, double* C, int bs) {
+    avx_block_body(n, A, B, C, bs, NULL);
+}
+void trace_naive(int n, double* A, double* B, double* C, int bs, CacheSim* sim) {
+    (void)bs; naive_body(n, A, B, C, sim);
+}
+void trace_avx(int n, double* A, double* B, double* C, int bs, CacheSim* sim) {
+    (void)bs; avx_body(n, A, B, C, sim);
+}
+void trace_avx_block(int n, double* A, double* B, double* C, int bs, CacheSim* sim) {
+    avx_block_body(n, A, B, C, bs, sim);
+}
+
+// --- MEDIÇÃO REAL ---
+double measure_gflops(void (*func)(int, double*, double*, double*, int), int n, int bs,
+                      double* A, double* B, double* C) {
+    clean_matrix(C, n);
+    func(n, A, B, C, bs);   // Aquecimento
+
+    double best = 1e9;
+    for (int r = 0; r < NUM_RUNS; r++) {
+        clean_matrix(C, n);
+        double start = get_time_sec();
+        func(n, A, B, C, bs);
+        double elapsed = get_time_sec() - start;
+        if (elapsed < best) best = elapsed;
+    }
+    return 2.0 * (double)n * n * n / best * 1e-9;
+}
+
+int main(int argc, char** argv) {
+    int n = (argc > 1) ? atoi(argv[1]) : N_PADRAO;
+    int block_sizes[] = {8, 16, 32, 64, 128, 256};
+    int num_bs = sizeof(block_sizes) / sizeof(block_sizes[0]);
+
+    CacheSim sim;
+    sim_init(&sim);
+
+    printf("=== SIMULADOR DE CACHE POR RASTRO: KERNELS DGEMM ===\n");
+    printf("==========================================================\n");
+    for (int l = 0; l < sim.num_levels; l++) {
+        printf("L%d: %6zu KB, %2d vias, %7zu conjuntos, linha %d B, LRU\n",
+               l + 1, sim.level[l].size / 1024, sim.level[l].ways, sim.level[l].sets, LINE_SIZE);
+    }
+    printf("(configurável com CACHE_L1=48:12 CACHE_L2=2048:16 CACHE_L3=32768:16, em KB:vias)\n");
+    printf("Matriz: %d x %d\n\n", n, n);
+
+    double* A = alloc_matrix(n, "Matriz A");
+    double* B = alloc_matrix(n, "Matriz B");
+    double* C = alloc_matrix(n, "Matriz C");
+
+    printf("+---------------------+-------------+------------+------------+------------+----------+----------+\n");
+    printf("| Kernel              | Acessos     | Falhas L1  | Falhas L2  | Falhas L3  | DRAM     | GFLOPS   |\n");
+    printf("|                     | (milhões)   | (milhões)  | (milhões)  | (milhões)  | (MB)     | medido   |\n");
+    printf("+---------------------+-------------+------------+------------+------------+----------+----------+\n");
+
+    struct {
+        const char* name;
+        void (*traced)(int, double*, double*, double*, int, CacheSim*);
+        void (*real)(int, double*, double*, double*, int);
+        int sweep;
+    } kernels[] = {
+        {"Naive (IKJ)", trace_naive, dgemm_naive, 0},
+        {"AVX (Pure)", trace_avx, dgemm_avx, 0},
+        {"AVX+Blocking", trace_avx_block, dgemm_avx_block, 1},
+    };
+
+    double sim_time = 0.0;
+    uint64_t total_accesses = 0;
+    for (int k = 0; k < 3; k++) {
+        int runs = kernels[k].sweep ? num_bs : 1;
+        for (int b = 0; b < runs; b++) {
+            int bs = kernels[k].sweep ? block_sizes[b] : 0;
+            char label[32];
+            if (kernels[k].sweep) snprintf(label, sizeof(label), "%s bs=%d", kernels[k].name, bs);
+            else snprintf(label, sizeof(label), "%s", kernels[k].name);
+
+            sim_reset(&sim);
+            clean_matrix(C, n);
+            double t0 = get_time_sec();
+            kernels[k].traced(n, A, B, C, bs, &sim);
+            sim_time += get_time_sec() - t0;
+            total_accesses += sim.level[0].accesses;
+
+            double gflops = measure_gflops(kernels[k].real, n, bs, A, B, C);
+            printf("| %-19s | %11.1f | %10.2f | %10.2f | %10.2f | %8.1f | %8.2f |\n",
+                   label, sim.level[0].accesses * 1e-6,
+                   sim.level[0].misses * 1e-6, sim.level[1].misses * 1e-6, sim.level[2].misses * 1e-6,
+                   sim.level[2].misses * (double)LINE_SIZE / (1024 * 1024), gflops);
+        }
+    }
+    printf("+---------------------+-------------+------------+------------+------------+----------+----------+\n");
+    printf("\nDRAM = falhas de L3 x %d bytes (tráfego previsto da memória principal)\n", LINE_SIZE);
+    printf("Simulação: %.1f s para %.0f milhões de acessos (%.1f ns/acesso)\n",
+           sim_time, total_accesses * 1e-6, sim_time / total_accesses * 1e9);
+
+    _mm_free(A);
+    _mm_free(B);
+    _mm_free(C);
+    for (int l = 0; l < sim.num_levels; l++) free(sim.level[l].tags);
+    return 0;
+}
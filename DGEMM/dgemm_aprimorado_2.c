@@ -5,14 +5,24 @@
 #include <immintrin.h>
 #include <stdint.h>
 #include <unistd.h>
+#include <pthread.h>
 
 // --- CONFIGURAÇÕES ---
 #define BLOCK_SIZE 32   // Otimizado para L1 Cache
 #define NUM_RUNS 5      // Execuções para média estatística
 #define WARMUP_RUNS 1   // Aquecimento de cache
-#define MAX_METHODS 3   // Número de métodos implementados
+#define MAX_METHODS 4   // Número de métodos implementados (4º só com --stream-c)
 #define MAX_SIZES 7     // Número máximo de tamanhos de matriz
 
+// --- MODO MICRO (matrizes pequenas, timer TSC) ---
+#define MICRO_MAX_N 128                 // Até este tamanho usa o timer TSC
+#define MICRO_MIN_CICLOS 2000000ULL     // Região medida mínima no modo quente
+#define MICRO_AMOSTRAS 200              // Chamadas medidas uma a uma no modo frio
+
+// --- PREPARAÇÃO (inicialização / zeragem) ---
+#define SETUP_NT_MIN_BYTES (8u << 20)   // A partir daqui: threads (clean com stores não temporais)
+#define SETUP_MAX_THREADS 64            // Limite de threads na preparação
+
 // --- ESTRUTURAS DE DADOS ---
 typedef struct {
     char vendor[13];
@@ -46,6 +56,48 @@ double get_time_sec() {
     return ts.tv_sec + ts.tv_nsec * 1e-9;
 }
 
+// --- TIMER TSC (Serializado) ---
+// get_time_sec não resolve uma chamada de poucos microssegundos (N=32 saía
+// "0.0000s"). Para tamanhos pequenos usamos o TSC com lfence/rdtscp, que
+// impedem o kernel de ser reordenado para fora da região medida.
+static double tsc_ghz = 0.0;        // Ticks do TSC por nanossegundo
+static uint64_t tsc_overhead = 0;   // Custo de um par tsc_inicio/tsc_fim vazio
+static int micro_cache_frio = 0;    // 0 = cache quente, 1 = cache frio
+static int stream_c = 0;            // 1 = roda também o kernel com stores não temporais em C
+
+static inline uint64_t tsc_inicio(void) {
+    _mm_lfence();
+    uint64_t t = __rdtsc();
+    _mm_lfence();
+    return t;
+}
+
+static inline uint64_t tsc_fim(void) {
+    unsigned int aux;
+    uint64_t t = __rdtscp(&aux);
+    _mm_lfence();
+    return t;
+}
+
+void calibrar_tsc(void) {
+    // Overhead: menor diferença entre duas leituras consecutivas
+    uint64_t melhor = UINT64_MAX;
+    for (int i = 0; i < 1000; i++) {
+        uint64_t t0 = tsc_inicio();
+        uint64_t t1 = tsc_fim();
+        if (t1 - t0 < melhor) melhor = t1 - t0;
+    }
+    tsc_overhead = melhor;
+    
+    // Frequência do TSC comparada com CLOCK_MONOTONIC (~50 ms)
+    double s0 = get_time_sec();
+    uint64_t c0 = tsc_inicio();
+    while (get_time_sec() - s0 < 0.05);
+    uint64_t c1 = tsc_fim();
+    double s1 = get_time_sec();
+    tsc_ghz = (double)(c1 - c0) / ((s1 - s0) * 1e9);
+}
+
 // --- DETECÇÃO SIMPLIFICADA DE CAPACIDADES DA CPU ---
 void detect_cpu_features(CPUInfo* cpu) {
     // Inicializar com valores padrão
@@ -133,24 +185,133 @@ void check_alignment(double* ptr, int required, const char* name) {
     }
 }
 
+// --- PREPARAÇÃO PARALELA ---
+// Cada clean_matrix passava 32 MB (N=2048) pela cache só para jogá-los fora.
+// Acima de SETUP_NT_MIN_BYTES a matriz é dividida entre threads:
+//  - init (alloc_matrix): store normal. É o primeiro toque das páginas e A, B
+//    são lidas logo em seguida pelo kernel; store não temporal aqui só
+//    deixava a inicialização mais lenta que a serial.
+//  - clean_matrix: _mm256_stream_pd. C zerada não é relida antes do kernel,
+//    então as linhas vão direto para a memória sem read-for-ownership e sem
+//    expulsar A e B da L3.
+// Abaixo do limite, ou com uma só thread, fica o caminho antigo (serial,
+// store normal), para não esfriar a cache do modo micro.
+static double setup_tabela[100] __attribute__((aligned(32)));  // (i % 100 + 1) * 0.01
+static double setup_clean_tempo = 0.0;  // Tempo acumulado em clean_matrix
+static long setup_clean_chamadas = 0;
+
+typedef struct {
+    double* ptr;
+    size_t begin;
+    size_t end;
+    int padrao;     // 1 = padrão de alloc_matrix, 0 = zeros
+} SetupTask;
+
+static void* setup_worker(void* arg) {
+    SetupTask* t = (SetupTask*)arg;
+    double* p = t->ptr;
+    size_t i = t->begin;
+    
+    // begin é múltiplo de 8: alinhado em 64 bytes e com i % 100 múltiplo de 4,
+    // então os 4 valores de setup_tabela nunca atravessam o fim da tabela
+    if (t->padrao) {
+        int m = (int)(i % 100);
+        for (; i + 4 <= t->end; i += 4) {
+            _mm256_store_pd(&p[i], _mm256_load_pd(&setup_tabela[m]));
+            m += 4;
+            if (m == 100) m = 0;
+        }
+        for (; i < t->end; i++) p[i] = setup_tabela[i % 100];
+    } else {
+        __m256d zero = _mm256_setzero_pd();
+        for (; i + 8 <= t->end; i += 8) {
+            _mm256_stream_pd(&p[i], zero);
+            _mm256_stream_pd(&p[i + 4], zero);
+        }
+        for (; i < t->end; i++) p[i] = 0.0;
+        _mm_sfence();   // Stores não temporais visíveis antes do join
+    }
+    return NULL;
+}
+
+static int setup_threads(void) {
+    int nthreads = sysconf(_SC_NPROCESSORS_ONLN);
+    if (nthreads < 1) nthreads = 1;
+    if (nthreads > SETUP_MAX_THREADS) nthreads = SETUP_MAX_THREADS;
+    return nthreads;
+}
+
+static void setup_fill(double* ptr, size_t count, int padrao) {
+    int nthreads = setup_threads();
+    if (count * sizeof(double) < SETUP_NT_MIN_BYTES || nthreads == 1) {
+        if (padrao) {
+            for (size_t i = 0; i < count; i++) ptr[i] = setup_tabela[i % 100];
+        } else {
+            memset(ptr, 0, count * sizeof(double));
+        }
+        return;
+    }
+    
+    pthread_t threads[SETUP_MAX_THREADS];
+    SetupTask tasks[SETUP_MAX_THREADS];
+    int started[SETUP_MAX_THREADS] = {0};
+    size_t chunk = ((count / nthreads) + 7) & ~(size_t)7;
+    
+    for (int t = 0; t < nthreads; t++) {
+        size_t b = (size_t)t * chunk;
+        size_t e = b + chunk;
+        if (b > count) b = count;
+        if (e > count || t == nthreads - 1) e = count;
+        tasks[t] = (SetupTask){ptr, b, e, padrao};
+    }
+    // A thread principal fica com o primeiro pedaço; se uma thread não puder
+    // ser criada, o pedaço dela roda aqui mesmo
+    for (int t = 1; t < nthreads; t++) {
+        if (pthread_create(&threads[t], NULL, setup_worker, &tasks[t]) == 0) started[t] = 1;
+        else setup_worker(&tasks[t]);
+    }
+    setup_worker(&tasks[0]);
+    for (int t = 1; t < nthreads; t++) {
+        if (started[t]) pthread_join(threads[t], NULL);
+    }
+}
+
 // --- ALOCAÇÃO E INICIALIZAÇÃO ---
 double* alloc_matrix(int n, const char* name) {
-    double* ptr = (double*)_mm_malloc(n * n * sizeof(double), 64);
+    double* ptr = (double*)_mm_malloc((size_t)n * n * sizeof(double), 64);
     if (!ptr) {
         printf("[ERRO] Falha ao alocar %s\n", name);
         exit(1);
     }
     
-    for (int i = 0; i < n * n; i++) {
-        ptr[i] = (double)((i % 100) + 1) * 0.01;
+    if (setup_tabela[0] == 0.0) {
+        for (int i = 0; i < 100; i++) setup_tabela[i] = (double)(i + 1) * 0.01;
     }
+    setup_fill(ptr, (size_t)n * n, 1);
     
     check_alignment(ptr, 64, name);
     return ptr;
 }
 
 void clean_matrix(double* C, int n) {
-    memset(C, 0, n * n * sizeof(double));
+    double t0 = get_time_sec();
+    setup_fill(C, (size_t)n * n, 0);
+    setup_clean_tempo += get_time_sec() - t0;
+    setup_clean_chamadas++;
+}
+
+// Caminho antigo (serial, store normal), só para comparação na tabela de preparação
+static void init_serial(double* ptr, int n) {
+    for (int i = 0; i < n * n; i++) {
+        ptr[i] = (double)((i % 100) + 1) * 0.01;
+    }
+}
+
+// Remove a matriz de todos os níveis de cache (modo micro com cache frio)
+void flush_matrix(double* M, int n) {
+    for (int i = 0; i < n * n; i += 8) {
+        _mm_clflush(&M[i]);
+    }
 }
 
 // --- KERNELS DGEMM ---
@@ -236,6 +397,75 @@ void dgemm_avx_block(int n, double* A, double* B, double* C) {
     }
 }
 
+// 4. AVX + BLOCKING com stores não temporais na última passada de k
+// Quando k chega a n-1 o valor de C[i][j] é final e o kernel não volta a
+// lê-lo; o store vai direto para a memória e não ocupa a cache de A e B.
+// Só vale quando o chamador também não relê C logo em seguida (--stream-c).
+void dgemm_avx_block_nt(int n, double* A, double* B, double* C) {
+    for (int i_blk = 0; i_blk < n; i_blk += BLOCK_SIZE) {
+        for (int k_blk = 0; k_blk < n; k_blk += BLOCK_SIZE) {
+            for (int j_blk = 0; j_blk < n; j_blk += BLOCK_SIZE) {
+                
+                int i_max = (i_blk + BLOCK_SIZE > n) ? n : i_blk + BLOCK_SIZE;
+                int k_max = (k_blk + BLOCK_SIZE > n) ? n : k_blk + BLOCK_SIZE;
+                int j_max = (j_blk + BLOCK_SIZE > n) ? n : j_blk + BLOCK_SIZE;
+                // Stream exige endereço alinhado em 32 bytes em todas as linhas
+                int nt_ok = (n % 4 == 0);
+
+                for (int i = i_blk; i < i_max; i++) {
+                    for (int k = k_blk; k < k_max; k++) {
+                        __m256d a_vec = _mm256_set1_pd(A[i * n + k]);
+                        
+                        int j = j_blk;
+                        if (nt_ok && k == n - 1) {
+                            for (; j <= j_max - 4; j += 4) {
+                                __m256d c_vec = _mm256_load_pd(&C[i * n + j]);
+                                __m256d b_vec = _mm256_load_pd(&B[k * n + j]);
+                                #ifdef __FMA__
+                                c_vec = _mm256_fmadd_pd(a_vec, b_vec, c_vec);
+                                #else
+                                c_vec = _mm256_add_pd(c_vec, _mm256_mul_pd(a_vec, b_vec));
+                                #endif
+                                _mm256_stream_pd(&C[i * n + j], c_vec);
+                            }
+                        }
+                        
+                        #ifdef __FMA__
+                        for (; j <= j_max - 8; j += 8) {
+                            __m256d c_vec1 = _mm256_load_pd(&C[i * n + j]);
+                            __m256d b_vec1 = _mm256_load_pd(&B[k * n + j]);
+                            c_vec1 = _mm256_fmadd_pd(a_vec, b_vec1, c_vec1);
+                            _mm256_store_pd(&C[i * n + j], c_vec1);
+                            
+                            __m256d c_vec2 = _mm256_load_pd(&C[i * n + j + 4]);
+                            __m256d b_vec2 = _mm256_load_pd(&B[k * n + j + 4]);
+                            c_vec2 = _mm256_fmadd_pd(a_vec, b_vec2, c_vec2);
+                            _mm256_store_pd(&C[i * n + j + 4], c_vec2);
+                        }
+                        #endif
+                        
+                        for (; j <= j_max - 4; j += 4) {
+                            __m256d c_vec = _mm256_load_pd(&C[i * n + j]);
+                            __m256d b_vec = _mm256_load_pd(&B[k * n + j]);
+                            #ifdef __FMA__
+                            c_vec = _mm256_fmadd_pd(a_vec, b_vec, c_vec);
+                            #else
+                            c_vec = _mm256_add_pd(c_vec, _mm256_mul_pd(a_vec, b_vec));
+                            #endif
+                            _mm256_store_pd(&C[i * n + j], c_vec);
+                        }
+                        
+                        for (; j < j_max; j++) {
+                            C[i * n + j] += A[i * n + k] * B[k * n + j];
+                        }
+                    }
+                }
+            }
+        }
+    }
+    _mm_sfence();
+}
+
 // --- BENCHMARK COMPLETO ---
 double run_benchmark(void (*func)(int, double*, double*, double*), 
                      int n, double* A, double* B, double* C, 
@@ -300,6 +530,112 @@ double run_benchmark(void (*func)(int, double*, double*, double*),
     return avg_gflops;
 }
 
+// --- BENCHMARK MICRO (Tamanhos pequenos) ---
+// Cache quente: repete o kernel dentro de uma única região TSC até passar de
+// MICRO_MIN_CICLOS e divide pelo número de repetições.
+// Cache frio: tira A, B e C da cache antes de cada chamada e mede uma a uma,
+// descontando o overhead do timer de cada amostra.
+double run_benchmark_micro(void (*func)(int, double*, double*, double*), 
+                           int n, double* A, double* B, double* C, 
+                           const char* name, double peak_gflops, 
+                           MethodResult* result, int method_idx, int size_idx) {
+    
+    printf("\n--- Executando (micro, cache %s): %s ---\n", 
+           micro_cache_frio ? "frio" : "quente", name);
+    
+    // Warm-up
+    for(int w = 0; w < WARMUP_RUNS; w++) {
+        clean_matrix(C, n);
+        func(n, A, B, C);
+    }
+    
+    // Calibrar número de repetições (apenas cache quente)
+    long reps = 1;
+    if (!micro_cache_frio) {
+        for (;;) {
+            uint64_t t0 = tsc_inicio();
+            for (long r = 0; r < reps; r++) func(n, A, B, C);
+            uint64_t t1 = tsc_fim();
+            if (t1 - t0 >= MICRO_MIN_CICLOS || reps >= (1L << 24)) break;
+            reps *= 2;
+        }
+    }
+    
+    double min_time = 1e9;
+    double max_time = 0;
+    double total_time = 0.0;
+    double total_gflops = 0.0;
+    double operations = 2.0 * (double)n * (double)n * (double)n;
+    
+    for (int r = 0; r < NUM_RUNS; r++) {
+        double ciclos = 0.0;
+        
+        if (!micro_cache_frio) {
+            clean_matrix(C, n);
+            uint64_t t0 = tsc_inicio();
+            for (long i = 0; i < reps; i++) func(n, A, B, C);
+            uint64_t t1 = tsc_fim();
+            uint64_t total = t1 - t0;
+            ciclos = (double)(total > tsc_overhead ? total - tsc_overhead : 0) / reps;
+        } else {
+            uint64_t soma = 0;
+            for (int a = 0; a < MICRO_AMOSTRAS; a++) {
+                clean_matrix(C, n);
+                flush_matrix(A, n);
+                flush_matrix(B, n);
+                flush_matrix(C, n);
+                _mm_mfence();
+                
+                uint64_t t0 = tsc_inicio();
+                func(n, A, B, C);
+                uint64_t t1 = tsc_fim();
+                uint64_t total = t1 - t0;
+                soma += (total > tsc_overhead) ? total - tsc_overhead : 0;
+            }
+            ciclos = (double)soma / MICRO_AMOSTRAS;
+        }
+        
+        double elapsed = ciclos / (tsc_ghz * 1e9);
+        double gflops = (elapsed > 0) ? (operations / elapsed) * 1e-9 : 0.0;
+        
+        total_time += elapsed;
+        total_gflops += gflops;
+        
+        if (elapsed < min_time) min_time = elapsed;
+        if (elapsed > max_time) max_time = elapsed;
+        
+        printf("  Execução %d: %.3f us, %.0f ciclos TSC (%.2f GFLOPS)\n", 
+               r+1, elapsed * 1e6, ciclos, gflops);
+    }
+    
+    double avg_time = total_time / NUM_RUNS;
+    double avg_gflops = total_gflops / NUM_RUNS;
+    double efficiency = (peak_gflops > 0) ? (avg_gflops / peak_gflops * 100.0) : 0.0;
+    
+    // Armazenar resultados
+    strcpy(result[method_idx].name, name);
+    result[method_idx].gflops[size_idx] = avg_gflops;
+    result[method_idx].time[size_idx] = avg_time;
+    result[method_idx].efficiency[size_idx] = efficiency;
+    
+    printf("\n  RESULTADO FINAL:\n");
+    printf("  Tempo médio:    %.3f us\n", avg_time * 1e6);
+    printf("  GFLOPS médio:   %.2f\n", avg_gflops);
+    if (max_time > min_time) {
+        printf("  Variação:       ±%.1f%%\n", ((max_time - min_time) / avg_time * 50.0));
+    }
+    if (peak_gflops > 0) {
+        printf("  Eficiência:     %.1f%% do pico teórico\n", efficiency);
+    }
+    if (!micro_cache_frio) {
+        printf("  Repetições:     %ld por medição\n", reps);
+    } else {
+        printf("  Amostras:       %d por medição\n", MICRO_AMOSTRAS);
+    }
+    
+    return avg_gflops;
+}
+
 // --- ESTIMATIVA DE DESEMPENHO PICO ---
 double estimate_peak_gflops(int cores, float freq) {
     return freq * cores * 8 * 2;
@@ -366,7 +702,9 @@ void print_results_matrix(MethodResult* results, int num_methods,
         printf("║ %4d x %-4d ║", n, n);
         
         for (int m = 0; m < num_methods; m++) {
-            if (results[m].time[s] > 0) {
+            if (results[m].time[s] > 0 && results[m].time[s] < 1e-3) {
+                printf(" %10.3f us             ║", results[m].time[s] * 1e6);
+            } else if (results[m].time[s] > 0) {
                 printf(" %10.4f s              ║", results[m].time[s]);
             } else {
                 printf(" %-28s ║", "N/A");
@@ -444,8 +782,31 @@ void print_results_matrix(MethodResult* results, int num_methods,
     }
 }
 
+// --- IMPRIMIR TEMPOS DE PREPARAÇÃO ---
+// Inicialização e zeragem ficam fora da região medida dos kernels; esta
+// tabela mostra quanto custam, separadamente do GFLOPS.
+void print_setup_table(int* sizes, int num_sizes, double* init_par, double* init_ser,
+                       double* clean_par, double* clean_ser) {
+    printf("\n╔══════════════════════════════════════════════════════════════════════════════════════════════════╗\n");
+    printf("║                           TEMPO DE PREPARAÇÃO (fora da região medida)                            ║\n");
+    printf("╠═════════════╦══════════════════╦══════════════════╦══════════════════╦══════════════════╦════════╣\n");
+    printf("║ Tamanho     ║ Init A,B,C (par) ║ Init A,B,C (ser) ║ clean C (par)    ║ clean C (memset) ║ Modo   ║\n");
+    printf("╠═════════════╬══════════════════╬══════════════════╬══════════════════╬══════════════════╬════════╣\n");
+    for (int s = 0; s < num_sizes; s++) {
+        int n = sizes[s];
+        if (init_par[s] <= 0) continue;
+        int par = (size_t)n * n * sizeof(double) >= SETUP_NT_MIN_BYTES && setup_threads() > 1;
+        printf("║ %4d x %-4d ║ %13.3f ms ║ %13.3f ms ║ %13.3f ms ║ %13.3f ms ║ %-6s ║\n",
+               n, n, init_par[s] * 1e3, init_ser[s] * 1e3, clean_par[s] * 1e3, clean_ser[s] * 1e3,
+               par ? "par" : "serial");
+    }
+    printf("╚═════════════╩══════════════════╩══════════════════╩══════════════════╩══════════════════╩════════╝\n");
+    printf("  par = %d threads (matriz >= %u MB): init com store normal, clean C com stores não temporais\n",
+           setup_threads(), SETUP_NT_MIN_BYTES >> 20);
+}
+
 // --- FUNÇÃO PRINCIPAL ---
-int main() {
+int main(int argc, char** argv) {
     printf("==========================================================\n");
     printf("           BENCHMARK DGEMM - OTIMIZAÇÃO AVX\n");
     printf("==========================================================\n");
@@ -453,6 +814,14 @@ int main() {
     // Configurar semente aleatória
     srand(time(NULL));
     
+    // Modo de cache para os tamanhos pequenos
+    for (int a = 1; a < argc; a++) {
+        if (strcmp(argv[a], "--cache-frio") == 0) micro_cache_frio = 1;
+        else if (strcmp(argv[a], "--cache-quente") == 0) micro_cache_frio = 0;
+        else if (strcmp(argv[a], "--stream-c") == 0) stream_c = 1;
+    }
+    calibrar_tsc();
+    
     // Informações do sistema
     CPUInfo cpu = {0};
     detect_cpu_features(&cpu);
@@ -476,8 +845,13 @@ int main() {
            current_freq, actual_cores);
     
     // Tamanhos das matrizes para teste
-    int sizes[] = {64, 128, 256, 512, 1024, 2048};
+    int sizes[] = {32, 64, 128, 256, 512, 1024, 2048};
     int num_sizes = sizeof(sizes) / sizeof(sizes[0]);
+    int num_methods = stream_c ? MAX_METHODS : MAX_METHODS - 1;
+    
+    // Tempos de preparação por tamanho (inicialização e zeragem de C)
+    double init_par[MAX_SIZES] = {0}, init_ser[MAX_SIZES] = {0};
+    double clean_par[MAX_SIZES] = {0}, clean_ser[MAX_SIZES] = {0};
     
     // Estrutura para armazenar resultados
     MethodResult results[MAX_METHODS];
@@ -493,6 +867,11 @@ int main() {
     printf("Block size:       %d (otimizado para cache L1)\n", BLOCK_SIZE);
     printf("Execuções:        %d por benchmark\n", NUM_RUNS);
     printf("Warm-up:          %d execução\n", WARMUP_RUNS);
+    printf("Modo micro:       N <= %d, timer TSC (%.2f GHz, overhead %llu ciclos)\n", 
+           MICRO_MAX_N, tsc_ghz, (unsigned long long)tsc_overhead);
+    printf("Cache (micro):    %s\n", micro_cache_frio ? "frio (--cache-frio)" : "quente (--cache-quente)");
+    printf("Preparação:       threads a partir de %u MB por matriz (stores NT só no clean C)\n", SETUP_NT_MIN_BYTES >> 20);
+    printf("Stream em C:      %s\n", stream_c ? "SIM (--stream-c)" : "NÃO");
     printf("\n");
 
     // Executar benchmarks para cada tamanho
@@ -512,15 +891,45 @@ int main() {
         printf("Processando matriz %dx%d (~%zu MB)...\n", n, n, mem_usage);
         printf("══════════════════════════════════════════════════════════════\n");
         
-        // Alocar matrizes
+        // Alocar matrizes (tempo de preparação medido à parte)
+        double t_init = get_time_sec();
         double* A = alloc_matrix(n, "Matriz A");
         double* B = alloc_matrix(n, "Matriz B");
         double* C = alloc_matrix(n, "Matriz C");
+        init_par[s] = get_time_sec() - t_init;
+        setup_clean_tempo = 0.0;
+        setup_clean_chamadas = 0;
         
         // Executar cada versão e armazenar resultados
-        run_benchmark(dgemm_naive, n, A, B, C, "Naive (IKJ)", peak_gflops, results, 0, s);
-        run_benchmark(dgemm_avx, n, A, B, C, "AVX (Pure)", peak_gflops, results, 1, s);
-        run_benchmark(dgemm_avx_block, n, A, B, C, "AVX+Blocking+Unroll", peak_gflops, results, 2, s);
+        // (tamanhos pequenos usam o modo micro com timer TSC)
+        double (*bench)(void (*)(int, double*, double*, double*), int, double*, double*, double*,
+                        const char*, double, MethodResult*, int, int) =
+            (n <= MICRO_MAX_N) ? run_benchmark_micro : run_benchmark;
+        bench(dgemm_naive, n, A, B, C, "Naive (IKJ)", peak_gflops, results, 0, s);
+        bench(dgemm_avx, n, A, B, C, "AVX (Pure)", peak_gflops, results, 1, s);
+        bench(dgemm_avx_block, n, A, B, C, "AVX+Blocking+Unroll", peak_gflops, results, 2, s);
+        if (stream_c) {
+            bench(dgemm_avx_block_nt, n, A, B, C, "AVX+Blocking+Stream C", peak_gflops, results, 3, s);
+        }
+        if (setup_clean_chamadas > 0) clean_par[s] = setup_clean_tempo / setup_clean_chamadas;
+        
+        // Referência: caminho antigo de preparação, em buffers novos para que
+        // os page faults do primeiro toque entrem na conta como em alloc_matrix
+        double* R[3];
+        for (int r = 0; r < 3; r++) {
+            R[r] = (double*)_mm_malloc((size_t)n * n * sizeof(double), 64);
+            if (!R[r]) {
+                printf("[ERRO] Falha ao alocar buffer de referência\n");
+                exit(1);
+            }
+        }
+        t_init = get_time_sec();
+        for (int r = 0; r < 3; r++) init_serial(R[r], n);
+        init_ser[s] = get_time_sec() - t_init;
+        for (int r = 0; r < 3; r++) _mm_free(R[r]);
+        t_init = get_time_sec();
+        memset(C, 0, (size_t)n * n * sizeof(double));
+        clean_ser[s] = get_time_sec() - t_init;
         
         // Liberar memória
         _mm_free(A); 
@@ -535,7 +944,8 @@ int main() {
     }
     
     // Imprimir matriz de resultados
-    print_results_matrix(results, MAX_METHODS, sizes, num_sizes, peak_gflops);
+    print_results_matrix(results, num_methods, sizes, num_sizes, peak_gflops);
+    print_setup_table(sizes, num_sizes, init_par, init_ser, clean_par, clean_ser);
     
     // Informações finais
     printf("\n══════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════════\n");
@@ -0,0 +1,460 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <string.h>
+#include <math.h>
+#include <immintrin.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <stdatomic.h>
+
+// --- CONFIGURAÇÕES ---
+#define BLOCK_SIZE 32           // Block size otimizado para L1 Cache
+#define MAX_THREADS 64          // Limite de workers da fila
+#define TILE_ROWS 32            // Linhas de C por tile
+#define SMALL_N 128             // Até aqui o GEMM é "pequeno": um tile só, com prioridade
+#define NUM_JOBS 400            // Chegadas por rodada
+#define SEED 12345              // Semente do gerador de chegadas
+
+// --- UTILITÁRIOS DE TEMPO (Alta Precisão) ---
+double get_time_sec() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// --- ALOCAÇÃO E INICIALIZAÇÃO ---
+double* alloc_matrix(int n, const char* name) {
+    double* ptr = (double*)_mm_malloc((size_t)n * n * sizeof(double), 64);
+    if (!ptr) {
+        printf("[ERRO] Falha ao alocar %s\n", name);
+        exit(1);
+    }
+
+    for (size_t i = 0; i < (size_t)n * n; i++) {
+        ptr[i] = (double)((i % 100) + 1) * 0.01;
+    }
+    return ptr;
+}
+
+void clean_matrix(double* C, int n) {
+    memset(C, 0, (size_t)n * n * sizeof(double));
+}
+
+// --- AVX + BLOCKING (linhas [row_begin, row_end) de C) ---
+void dgemm_avx_block_rows(int n, double* A, double* B, double* C, int row_begin, int row_end) {
+    for (int i_blk = row_begin; i_blk < row_end; i_blk += BLOCK_SIZE) {
+        for (int k_blk = 0; k_blk < n; k_blk += BLOCK_SIZE) {
+            for (int j_blk = 0; j_blk < n; j_blk += BLOCK_SIZE) {
+
+                int i_max = (i_blk + BLOCK_SIZE > row_end) ? row_end : i_blk + BLOCK_SIZE;
+                int k_max = (k_blk + BLOCK_SIZE > n) ? n : k_blk + BLOCK_SIZE;
+                int j_max = (j_blk + BLOCK_SIZE > n) ? n : j_blk + BLOCK_SIZE;
+
+                for (int i = i_blk; i < i_max; i++) {
+                    for (int k = k_blk; k < k_max; k++) {
+                        __m256d a_vec = _mm256_set1_pd(A[i * n + k]);
+
+                        int j = j_blk;
+                        #ifdef __FMA__
+                        for (; j <= j_max - 8; j += 8) {
+                            __m256d c_vec1 = _mm256_load_pd(&C[i * n + j]);
+                            __m256d b_vec1 = _mm256_load_pd(&B[k * n + j]);
+                            c_vec1 = _mm256_fmadd_pd(a_vec, b_vec1, c_vec1);
+                            _mm256_store_pd(&C[i * n + j], c_vec1);
+
+                            __m256d c_vec2 = _mm256_load_pd(&C[i * n + j + 4]);
+                            __m256d b_vec2 = _mm256_load_pd(&B[k * n + j + 4]);
+                            c_vec2 = _mm256_fmadd_pd(a_vec, b_vec2, c_vec2);
+                            _mm256_store_pd(&C[i * n + j + 4], c_vec2);
+                        }
+                        #endif
+
+                        for (; j <= j_max - 4; j += 4) {
+                            __m256d c_vec = _mm256_load_pd(&C[i * n + j]);
+                            __m256d b_vec = _mm256_load_pd(&B[k * n + j]);
+                            #ifdef __FMA__
+                            c_vec = _mm256_fmadd_pd(a_vec, b_vec, c_vec);
+                            #else
+                            c_vec = _mm256_add_pd(c_vec, _mm256_mul_pd(a_vec, b_vec));
+                            #endif
+                            _mm256_store_pd(&C[i * n + j], c_vec);
+                        }
+
+                        for (; j < j_max; j++) {
+                            C[i * n + j] += A[i * n + k] * B[k * n + j];
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+// ============================================================
+// --- FILA ASSÍNCRONA DE GEMM ---
+// ============================================================
+// gemm_submit devolve um handle na hora; os workers tiram tiles (faixas de
+// TILE_ROWS linhas de C) de qualquer GEMM pendente. Duas políticas:
+//   POL_FIFO  - todos os workers no GEMM mais antigo até acabar os tiles
+//               dele (equivale a chamadas síncronas paralelas em sequência)
+//   POL_MISTO - GEMMs pequenos (n <= SMALL_N) viram um tile único e são
+//               servidos antes dos tiles dos grandes, então vários pequenos
+//               rodam lado a lado enquanto um grande ocupa o resto
+typedef enum { POL_FIFO, POL_MISTO } Politica;
+
+typedef struct GemmHandle {
+    int n;
+    double *A, *B, *C;
+    int num_tiles, tile_rows;
+    int next_tile;                  // Próximo tile a distribuir (sob q->lock)
+    atomic_int tiles_left;          // Tiles ainda não concluídos
+    atomic_int done;
+    double t_submit, t_done;
+    struct GemmHandle* next;        // Lista de pendentes
+} GemmHandle;
+
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t work_cond;       // Workers esperando tile
+    pthread_cond_t done_cond;       // gemm_wait esperando término
+    GemmHandle *head, *tail;        // GEMMs com tiles ainda não distribuídos
+    Politica politica;
+    int stop;
+    int nworkers;
+    pthread_t threads[MAX_THREADS];
+} GemmQueue;
+
+// Escolhe o próximo tile (sob q->lock). Retorna o handle e o índice do tile.
+static GemmHandle* pick_tile(GemmQueue* q, int* tile) {
+    GemmHandle* h = q->head;
+    GemmHandle* prev = NULL;
+    if (!h) return NULL;
+
+    if (q->politica == POL_MISTO && h->n > SMALL_N) {
+        GemmHandle* p = NULL;
+        for (GemmHandle* it = h; it; p = it, it = it->next) {
+            if (it->n <= SMALL_N) {
+                h = it;
+                prev = p;
+                break;
+            }
+        }
+    }
+
+    *tile = h->next_tile++;
+    if (h->next_tile == h->num_tiles) {   // Último tile distribuído: sai da lista
+        if (prev) prev->next = h->next;
+        else q->head = h->next;
+        if (q->tail == h) q->tail = prev;
+        h->next = NULL;
+    }
+    return h;
+}
+
+static void* queue_worker(void* p) {
+    GemmQueue* q = (GemmQueue*)p;
+
+    for (;;) {
+        pthread_mutex_lock(&q->lock);
+        while (!q->head && !q->stop) pthread_cond_wait(&q->work_cond, &q->lock);
+        if (!q->head && q->stop) {
+            pthread_mutex_unlock(&q->lock);
+            break;
+        }
+        int tile;
+        GemmHandle* h = pick_tile(q, &tile);
+        pthread_mutex_unlock(&q->lock);
+
+        int r0 = tile * h->tile_rows;
+        int r1 = (r0 + h->tile_rows > h->n) ? h->n : r0 + h->tile_rows;
+        dgemm_avx_block_rows(h->n, h->A, h->B, h->C, r0, r1);
+
+        if (atomic_fetch_sub_explicit(&h->tiles_left, 1, memory_order_acq_rel) == 1) {
+            h->t_done = get_time_sec();
+            pthread_mutex_lock(&q->lock);
+            atomic_store_explicit(&h->done, 1, memory_order_release);
+            pthread_cond_broadcast(&q->done_cond);
+            pthread_mutex_unlock(&q->lock);
+        }
+    }
+    return NULL;
+}
+
+void queue_init(GemmQueue* q, int nworkers, Politica politica) {
+    if (nworkers < 1) nworkers = 1;
+    if (nworkers > MAX_THREADS) nworkers = MAX_THREADS;
+    memset(q, 0, sizeof(*q));
+    q->nworkers = nworkers;
+    q->politica = politica;
+    pthread_mutex_init(&q->lock, NULL);
+    pthread_cond_init(&q->work_cond, NULL);
+    pthread_cond_init(&q->done_cond, NULL);
+    for (int t = 0; t < nworkers; t++) {
+        if (pthread_create(&q->threads[t], NULL, queue_worker, q) != 0) {
+            printf("[ERRO] Falha ao criar worker %d da fila\n", t);
+            exit(1);
+        }
+    }
+}
+
+void queue_destroy(GemmQueue* q) {
+    pthread_mutex_lock(&q->lock);
+    q->stop = 1;
+    pthread_cond_broadcast(&q->work_cond);
+    pthread_mutex_unlock(&q->lock);
+    for (int t = 0; t < q->nworkers; t++) pthread_join(q->threads[t], NULL);
+    pthread_mutex_destroy(&q->lock);
+    pthread_cond_destroy(&q->work_cond);
+    pthread_cond_destroy(&q->done_cond);
+}
+
+// C += A * B de forma assíncrona. C não pode ser tocada até gemm_poll/gemm_wait.
+GemmHandle* gemm_submit(GemmQueue* q, int n, double* A, double* B, double* C) {
+    GemmHandle* h = (GemmHandle*)calloc(1, sizeof(GemmHandle));
+    if (!h) {
+        printf("[ERRO] Falha ao alocar handle\n");
+        exit(1);
+    }
+    h->n = n;
+    h->A = A;
+    h->B = B;
+    h->C = C;
+    h->tile_rows = (q->politica == POL_MISTO && n <= SMALL_N) ? n : TILE_ROWS;
+    h->num_tiles = (n + h->tile_rows - 1) / h->tile_rows;
+    atomic_init(&h->tiles_left, h->num_tiles);
+    atomic_init(&h->done, 0);
+    h->t_submit = get_time_sec();
+
+    pthread_mutex_lock(&q->lock);
+    if (q->tail) q->tail->next = h;
+    else q->head = h;
+    q->tail = h;
+    if (h->num_tiles > 1) pthread_cond_broadcast(&q->work_cond);
+    else pthread_cond_signal(&q->work_cond);
+    pthread_mutex_unlock(&q->lock);
+    return h;
+}
+
+int gemm_poll(GemmHandle* h) {
+    return atomic_load_explicit(&h->done, memory_order_acquire);
+}
+
+void gemm_wait(GemmQueue* q, GemmHandle* h) {
+    if (gemm_poll(h)) return;
+    pthread_mutex_lock(&q->lock);
+    while (!atomic_load_explicit(&h->done, memory_order_acquire)) {
+        pthread_cond_wait(&q->done_cond, &q->lock);
+    }
+    pthread_mutex_unlock(&q->lock);
+}
+
+void gemm_release(GemmHandle* h) {
+    free(h);
+}
+
+// ============================================================
+// --- BENCHMARK: FLUXO SINTÉTICO DE CHEGADAS ---
+// ============================================================
+// Mistura de tamanhos com chegadas de Poisson. A taxa é escolhida para dar
+// a carga pedida em relação à capacidade medida (serviço médio / workers).
+typedef struct {
+    int n;
+    double prob;
+    double *A, *B, *ref;
+    double service;                 // Tempo serial medido (s)
+} SizeClass;
+
+static SizeClass classes[] = {
+    {64, 0.60, NULL, NULL, NULL, 0.0},
+    {128, 0.25, NULL, NULL, NULL, 0.0},
+    {256, 0.10, NULL, NULL, NULL, 0.0},
+    {512, 0.05, NULL, NULL, NULL, 0.0},
+};
+#define NUM_CLASSES (int)(sizeof(classes) / sizeof(classes[0]))
+
+typedef struct {
+    int cls[NUM_JOBS];
+    double arrival[NUM_JOBS];       // Instante relativo de chegada (s)
+} Stream;
+
+static double uniform01(unsigned* state) {
+    return (rand_r(state) + 0.5) / ((double)RAND_MAX + 1.0);
+}
+
+void make_stream(Stream* st, double rate) {
+    unsigned state = SEED;
+    double t = 0.0;
+    for (int j = 0; j < NUM_JOBS; j++) {
+        double u = uniform01(&state), acc = 0.0;
+        int c = NUM_CLASSES - 1;
+        for (int k = 0; k < NUM_CLASSES; k++) {
+            acc += classes[k].prob;
+            if (u < acc) { c = k; break; }
+        }
+        st->cls[j] = c;
+        t += -log(uniform01(&state)) / rate;
+        st->arrival[j] = t;
+    }
+}
+
+static int cmp_double(const void* a, const void* b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+static double percentile(double* sorted, int count, double p) {
+    if (count == 0) return 0.0;
+    int idx = (int)ceil(p * count) - 1;
+    if (idx < 0) idx = 0;
+    if (idx >= count) idx = count - 1;
+    return sorted[idx];
+}
+
+static void sleep_until(double t_abs) {
+    double now = get_time_sec();
+    if (t_abs <= now) return;
+    double d = t_abs - now;
+    struct timespec ts = {(time_t)d, (long)((d - (time_t)d) * 1e9)};
+    nanosleep(&ts, NULL);
+}
+
+typedef struct {
+    double throughput, gflops;
+    double p50, p95, p99, max;          // Todos os GEMMs (ms)
+    double s_p50, s_p99;                // Só os pequenos (ms)
+    double l_p50, l_p99;                // Só os grandes (ms)
+} RunStats;
+
+RunStats run_stream(int nworkers, Politica pol, const Stream* st) {
+    static GemmHandle* handles[NUM_JOBS];
+    static double* Cs[NUM_JOBS];
+    static double lat_all[NUM_JOBS], lat_small[NUM_JOBS], lat_large[NUM_JOBS];
+    GemmQueue q;
+    queue_init(&q, nworkers, pol);
+
+    for (int j = 0; j < NUM_JOBS; j++) {
+        int n = classes[st->cls[j]].n;
+        Cs[j] = alloc_matrix(n, "Matriz C do job");
+        clean_matrix(Cs[j], n);
+    }
+
+    double flops = 0.0;
+    double t0 = get_time_sec();
+    for (int j = 0; j < NUM_JOBS; j++) {
+        sleep_until(t0 + st->arrival[j]);
+        SizeClass* c = &classes[st->cls[j]];
+        handles[j] = gemm_submit(&q, c->n, c->A, c->B, Cs[j]);
+        flops += 2.0 * c->n * c->n * c->n;
+    }
+    for (int j = 0; j < NUM_JOBS; j++) gemm_wait(&q, handles[j]);
+    double t_end = get_time_sec();
+
+    int ns = 0, nl = 0;
+    for (int j = 0; j < NUM_JOBS; j++) {
+        SizeClass* c = &classes[st->cls[j]];
+        double lat = (handles[j]->t_done - handles[j]->t_submit) * 1e3;
+        lat_all[j] = lat;
+        if (c->n <= SMALL_N) lat_small[ns++] = lat;
+        else lat_large[nl++] = lat;
+
+        // Todos os jobs da mesma classe usam A e B iguais: C deve bater com a referência
+        for (size_t i = 0; i < (size_t)c->n * c->n; i += 97) {
+            if (fabs(Cs[j][i] - c->ref[i]) > 1e-9) {
+                printf("[ERRO] Job %d (n=%d) diverge da referência\n", j, c->n);
+                exit(1);
+            }
+        }
+        gemm_release(handles[j]);
+        _mm_free(Cs[j]);
+    }
+    queue_destroy(&q);
+
+    qsort(lat_all, NUM_JOBS, sizeof(double), cmp_double);
+    qsort(lat_small, ns, sizeof(double), cmp_double);
+    qsort(lat_large, nl, sizeof(double), cmp_double);
+
+    RunStats r;
+    r.throughput = NUM_JOBS / (t_end - t0);
+    r.gflops = flops / (t_end - t0) * 1e-9;
+    r.p50 = percentile(lat_all, NUM_JOBS, 0.50);
+    r.p95 = percentile(lat_all, NUM_JOBS, 0.95);
+    r.p99 = percentile(lat_all, NUM_JOBS, 0.99);
+    r.max = lat_all[NUM_JOBS - 1];
+    r.s_p50 = percentile(lat_small, ns, 0.50);
+    r.s_p99 = percentile(lat_small, ns, 0.99);
+    r.l_p50 = percentile(lat_large, nl, 0.50);
+    r.l_p99 = percentile(lat_large, nl, 0.99);
+    return r;
+}
+
+int main(int argc, char** argv) {
+    int ncpu = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    int nworkers = (argc > 1) ? atoi(argv[1]) : ncpu;
+    double loads[] = {0.5, 0.8, 0.95};
+    int num_loads = sizeof(loads) / sizeof(loads[0]);
+
+    printf("=== FILA ASSÍNCRONA DE GEMM: VAZÃO E LATÊNCIA DE CAUDA ===\n");
+    printf("==========================================================\n");
+    printf("Workers: %d | tile: %d linhas | pequeno: n <= %d | %d chegadas por rodada\n\n",
+           nworkers, TILE_ROWS, SMALL_N, NUM_JOBS);
+
+    // Dados e referência por classe, e tempo de serviço serial
+    double mean_service = 0.0;
+    printf("Classe  Prob   Serviço serial\n");
+    for (int c = 0; c < NUM_CLASSES; c++) {
+        int n = classes[c].n;
+        classes[c].A = alloc_matrix(n, "Matriz A");
+        classes[c].B = alloc_matrix(n, "Matriz B");
+        classes[c].ref = alloc_matrix(n, "Matriz Ref");
+        clean_matrix(classes[c].ref, n);
+        dgemm_avx_block_rows(n, classes[c].A, classes[c].B, classes[c].ref, 0, n);
+
+        double* tmp = alloc_matrix(n, "Matriz temporária");
+        int reps = 0;
+        double start = get_time_sec(), elapsed;
+        do {
+            dgemm_avx_block_rows(n, classes[c].A, classes[c].B, tmp, 0, n);
+            reps++;
+            elapsed = get_time_sec() - start;
+        } while (elapsed < 0.1);
+        classes[c].service = elapsed / reps;
+        _mm_free(tmp);
+
+        mean_service += classes[c].prob * classes[c].service;
+        printf("n=%-4d  %4.0f%%  %10.3f ms\n", n, classes[c].prob * 100, classes[c].service * 1e3);
+    }
+    int cores = nworkers < ncpu ? nworkers : ncpu;
+    double capacity = cores / mean_service;
+    printf("Capacidade estimada: %.0f GEMMs/s\n\n", capacity);
+
+    printf("+-------+--------+----------+--------+---------------------------------+---------------+---------------+\n");
+    printf("| Carga | Modo   | GEMMs/s  | GFLOPS | Latência todos (ms) p50/p95/p99 | Peq. p50/p99  | Gran. p50/p99 |\n");
+    printf("+-------+--------+----------+--------+---------------------------------+---------------+---------------+\n");
+
+    for (int l = 0; l < num_loads; l++) {
+        Stream st;
+        make_stream(&st, loads[l] * capacity);
+        Politica pols[2] = {POL_FIFO, POL_MISTO};
+        const char* nomes[2] = {"FIFO", "Misto"};
+        for (int p = 0; p < 2; p++) {
+            RunStats r = run_stream(nworkers, pols[p], &st);
+            printf("| %4.0f%% | %-6s | %8.1f | %6.2f | %9.2f %9.2f %9.2f   | %6.2f %6.2f | %6.2f %6.2f |\n",
+                   loads[l] * 100, nomes[p], r.throughput, r.gflops, r.p50, r.p95, r.p99,
+                   r.s_p50, r.s_p99, r.l_p50, r.l_p99);
+        }
+    }
+    printf("+-------+--------+----------+--------+---------------------------------+---------------+---------------+\n");
+    printf("\nFIFO  = um GEMM por vez, tiles dele espalhados por todos os workers (modelo síncrono)\n");
+    printf("Misto = pequenos como tile único com prioridade, intercalados com tiles dos grandes\n");
+    printf("Latência = submit até o último tile concluído\n");
+
+    for (int c = 0; c < NUM_CLASSES; c++) {
+        _mm_free(classes[c].A);
+        _mm_free(classes[c].B);
+        _mm_free(classes[c].ref);
+    }
+    return 0;
+}
@@ -0,0 +1,332 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <string.h>
+#include <math.h>
+#include <immintrin.h>
+#include <stdint.h>
+#include <unistd.h>
+
+// --- CONFIGURAÇÕES ---
+#define BLOCK_SIZE 32       // Block size do kernel de referência
+#define KB_DD 256           // Bloco de K dos kernels compensados
+#define NUM_RUNS 3          // Execuções para média estatística
+#define NUM_AMOSTRAS 256    // Elementos de C conferidos contra a referência __float128
+
+// Nível de precisão (o "botão" precisão x custo)
+#define PREC_PADRAO 0       // FMA simples
+#define PREC_SOMA 1         // TwoSum na acumulação (erro do produto ignorado)
+#define PREC_DD 2           // TwoSum + TwoProduct via FMA (double-double)
+
+// --- UTILITÁRIOS DE TEMPO (Alta Precisão) ---
+double get_time_sec() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// --- ALOCAÇÃO E INICIALIZAÇÃO ---
+double* alloc_matrix(int n, const char* name) {
+    double* ptr = (double*)_mm_malloc(n * n * sizeof(double), 64);
+    if (!ptr) {
+        printf("[ERRO] Falha ao alocar %s\n", name);
+        exit(1);
+    }
+
+    for (int i = 0; i < n * n; i++) {
+        ptr[i] = (double)((i % 100) + 1) * 0.01;
+    }
+    return ptr;
+}
+
+// Dados com cancelamento: sinais alternados e expoentes de 2^-20 a 2^20,
+// o caso em que a soma em double perde dígitos para K grande
+void fill_cancellation(double* M, int n, unsigned int seed) {
+    srand(seed);
+    for (int i = 0; i < n * n; i++) {
+        double mant = (double)rand() / RAND_MAX + 0.5;
+        int expo = rand() % 41 - 20;
+        M[i] = ((rand() & 1) ? -1.0 : 1.0) * ldexp(mant, expo);
+    }
+}
+
+void clean_matrix(double* C, int n) {
+    memset(C, 0, n * n * sizeof(double));
+}
+
+// --- REFERÊNCIA: AVX + BLOCKING (dgemm_aprimorado_2.c) ---
+void dgemm_avx_block(int n, double* A, double* B, double* C) {
+    for (int i_blk = 0; i_blk < n; i_blk += BLOCK_SIZE) {
+        for (int k_blk = 0; k_blk < n; k_blk += BLOCK_SIZE) {
+            for (int j_blk = 0; j_blk < n; j_blk += BLOCK_SIZE) {
+
+                int i_max = (i_blk + BLOCK_SIZE > n) ? n : i_blk + BLOCK_SIZE;
+                int k_max = (k_blk + BLOCK_SIZE > n) ? n : k_blk + BLOCK_SIZE;
+                int j_max = (j_blk + BLOCK_SIZE > n) ? n : j_blk + BLOCK_SIZE;
+
+                for (int i = i_blk; i < i_max; i++) {
+                    for (int k = k_blk; k < k_max; k++) {
+                        __m256d a_vec = _mm256_set1_pd(A[i * n + k]);
+                        int j = j_blk;
+                        for (; j <= j_max - 4; j += 4) {
+                            __m256d c_vec = _mm256_load_pd(&C[i * n + j]);
+                            __m256d b_vec = _mm256_load_pd(&B[k * n + j]);
+                            #ifdef __FMA__
+                            c_vec = _mm256_fmadd_pd(a_vec, b_vec, c_vec);
+                            #else
+                            c_vec = _mm256_add_pd(c_vec, _mm256_mul_pd(a_vec, b_vec));
+                            #endif
+                            _mm256_store_pd(&C[i * n + j], c_vec);
+                        }
+                        for (; j < j_max; j++) {
+                            C[i * n + j] += A[i * n + k] * B[k * n + j];
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+// --- TRANSFORMAÇÕES SEM ERRO (vetoriais) ---
+// TwoSum (Knuth): s + e == a + b exatamente, sem exigir |a| >= |b|
+static inline __attribute__((always_inline))
+void two_sum_pd(__m256d a, __m256d b, __m256d* s, __m256d* e) {
+    __m256d t = _mm256_add_pd(a, b);
+    __m256d z = _mm256_sub_pd(t, a);
+    *e = _mm256_add_pd(_mm256_sub_pd(a, _mm256_sub_pd(t, z)), _mm256_sub_pd(b, z));
+    *s = t;
+}
+
+// TwoProduct: p + e == a * b exatamente (FMA, ou divisão de Dekker sem FMA)
+static inline __attribute__((always_inline))
+void two_prod_pd(__m256d a, __m256d b, __m256d* p, __m256d* e) {
+    *p = _mm256_mul_pd(a, b);
+    #ifdef __FMA__
+    *e = _mm256_fmsub_pd(a, b, *p);
+    #else
+    const __m256d split = _mm256_set1_pd(134217729.0);     // 2^27 + 1
+    __m256d ca = _mm256_mul_pd(split, a), cb = _mm256_mul_pd(split, b);
+    __m256d ah = _mm256_sub_pd(ca, _mm256_sub_pd(ca, a)), al = _mm256_sub_pd(a, ah);
+    __m256d bh = _mm256_sub_pd(cb, _mm256_sub_pd(cb, b)), bl = _mm256_sub_pd(b, bh);
+    __m256d t = _mm256_sub_pd(_mm256_mul_pd(ah, bh), *p);
+    t = _mm256_add_pd(t, _mm256_mul_pd(ah, bl));
+    t = _mm256_add_pd(t, _mm256_mul_pd(al, bh));
+    *e = _mm256_add_pd(t, _mm256_mul_pd(al, bl));
+    #endif
+}
+
+// Um passo de acumulação (hi, lo) += a * b no nível de precisão pedido
+static inline __attribute__((always_inline))
+void acc_step(int prec, __m256d a, __m256d b, __m256d* hi, __m256d* lo) {
+    if (prec == PREC_PADRAO) {
+        #ifdef __FMA__
+        *hi = _mm256_fmadd_pd(a, b, *hi);
+        #else
+        *hi = _mm256_add_pd(*hi, _mm256_mul_pd(a, b));
+        #endif
+    } else if (prec == PREC_SOMA) {
+        __m256d p = _mm256_mul_pd(a, b), e;
+        two_sum_pd(*hi, p, hi, &e);
+        *lo = _mm256_add_pd(*lo, e);
+    } else {
+        __m256d p, ep, es;
+        two_prod_pd(a, b, &p, &ep);
+        two_sum_pd(*hi, p, hi, &es);
+        *lo = _mm256_add_pd(*lo, _mm256_add_pd(es, ep));
+    }
+}
+
+// --- KERNEL COMPENSADO ---
+// Tile 2 linhas x 8 colunas: (hi, lo) ficam em registradores durante todo o
+// bloco de K; C_lo guarda a parte baixa entre blocos e é somada no final.
+static inline __attribute__((always_inline))
+void dgemm_comp_kernel(int prec, int n, const double* A, const double* B, double* C, double* C_lo) {
+    for (int k_blk = 0; k_blk < n; k_blk += KB_DD) {
+        int k_max = (k_blk + KB_DD > n) ? n : k_blk + KB_DD;
+
+        for (int i = 0; i < n; i += 2) {
+            int two = (i + 1 < n);
+            const double* a0 = &A[i * n];
+            const double* a1 = two ? &A[(i + 1) * n] : a0;
+
+            int j = 0;
+            for (; j <= n - 8; j += 8) {
+                double* c0 = &C[i * n + j];
+                double* l0 = &C_lo[i * n + j];
+                double* c1 = two ? c0 + n : c0;
+                double* l1 = two ? l0 + n : l0;
+
+                __m256d h00 = _mm256_loadu_pd(c0), h01 = _mm256_loadu_pd(c0 + 4);
+                __m256d h10 = _mm256_loadu_pd(c1), h11 = _mm256_loadu_pd(c1 + 4);
+                __m256d e00 = _mm256_loadu_pd(l0), e01 = _mm256_loadu_pd(l0 + 4);
+                __m256d e10 = _mm256_loadu_pd(l1), e11 = _mm256_loadu_pd(l1 + 4);
+
+                for (int k = k_blk; k < k_max; k++) {
+                    __m256d b0 = _mm256_loadu_pd(&B[k * n + j]);
+                    __m256d b1 = _mm256_loadu_pd(&B[k * n + j + 4]);
+                    __m256d x0 = _mm256_broadcast_sd(&a0[k]);
+                    __m256d x1 = _mm256_broadcast_sd(&a1[k]);
+                    acc_step(prec, x0, b0, &h00, &e00);
+                    acc_step(prec, x0, b1, &h01, &e01);
+                    acc_step(prec, x1, b0, &h10, &e10);
+                    acc_step(prec, x1, b1, &h11, &e11);
+                }
+
+                // Linha 1 primeiro: se não existir, aponta para a linha 0 e é sobrescrita
+                _mm256_storeu_pd(c1, h10); _mm256_storeu_pd(c1 + 4, h11);
+                _mm256_storeu_pd(l1, e10); _mm256_storeu_pd(l1 + 4, e11);
+                _mm256_storeu_pd(c0, h00); _mm256_storeu_pd(c0 + 4, h01);
+                _mm256_storeu_pd(l0, e00); _mm256_storeu_pd(l0 + 4, e01);
+            }
+
+            // Colunas restantes: mesma aritmética, escalar
+            for (; j < n; j++) {
+                for (int r = 0; r < 1 + two; r++) {
+                    const double* a = r ? a1 : a0;
+                    __m256d hi = _mm256_set1_pd(C[(i + r) * n + j]);
+                    __m256d lo = _mm256_set1_pd(C_lo[(i + r) * n + j]);
+                    for (int k = k_blk; k < k_max; k++) {
+                        acc_step(prec, _mm256_set1_pd(a[k]), _mm256_set1_pd(B[k * n + j]), &hi, &lo);
+                    }
+                    C[(i + r) * n + j] = _mm256_cvtsd_f64(hi);
+                    C_lo[(i + r) * n + j] = _mm256_cvtsd_f64(lo);
+                }
+            }
+        }
+    }
+
+    // Renormaliza: C = hi + lo
+    if (prec != PREC_PADRAO) {
+        for (int i = 0; i < n * n; i++) C[i] += C_lo[i];
+    }
+}
+
+static double* scratch_lo = NULL;
+
+void dgemm_tile_padrao(int n, double* A, double* B, double* C) {
+    dgemm_comp_kernel(PREC_PADRAO, n, A, B, C, scratch_lo);
+}
+
+void dgemm_tile_soma(int n, double* A, double* B, double* C) {
+    memset(scratch_lo, 0, (size_t)n * n * sizeof(double));
+    dgemm_comp_kernel(PREC_SOMA, n, A, B, C, scratch_lo);
+}
+
+void dgemm_tile_dd(int n, double* A, double* B, double* C) {
+    memset(scratch_lo, 0, (size_t)n * n * sizeof(double));
+    dgemm_comp_kernel(PREC_DD, n, A, B, C, scratch_lo);
+}
+
+// --- REFERÊNCIA DE ALTA PRECISÃO (__float128, amostrada) ---
+typedef struct {
+    int i[NUM_AMOSTRAS];
+    int j[NUM_AMOSTRAS];
+    double ref[NUM_AMOSTRAS];
+} Reference;
+
+void build_reference(int n, const double* A, const double* B, Reference* ref) {
+    srand(12345);
+    for (int s = 0; s < NUM_AMOSTRAS; s++) {
+        int i = rand() % n;
+        int j = rand() % n;
+        __float128 sum = 0;
+        for (int k = 0; k < n; k++) {
+            sum += (__float128)A[i * n + k] * (__float128)B[k * n + j];
+        }
+        ref->i[s] = i;
+        ref->j[s] = j;
+        ref->ref[s] = (double)sum;
+    }
+}
+
+double max_rel_error(int n, const double* C, const Reference* ref) {
+    double worst = 0.0;
+    for (int s = 0; s < NUM_AMOSTRAS; s++) {
+        double r = ref->ref[s];
+        double d = fabs(C[ref->i[s] * n + ref->j[s]] - r);
+        double rel = (r != 0.0) ? d / fabs(r) : d;
+        if (rel > worst) worst = rel;
+    }
+    return worst;
+}
+
+// --- BENCHMARK ---
+double run_benchmark(void (*func)(int, double*, double*, double*), int n,
+                     double* A, double* B, double* C) {
+    double total_time = 0.0;
+    for (int r = 0; r < NUM_RUNS; r++) {
+        clean_matrix(C, n);
+        double start = get_time_sec();
+        func(n, A, B, C);
+        total_time += get_time_sec() - start;
+    }
+    return total_time / NUM_RUNS;
+}
+
+int main() {
+    int sizes[] = {256, 512, 1024};
+    int num_sizes = sizeof(sizes) / sizeof(sizes[0]);
+    const char* datasets[] = {"padrão (0.01..1)", "cancelamento"};
+
+    struct {
+        const char* name;
+        void (*func)(int, double*, double*, double*);
+    } methods[] = {
+        {"AVX+Blocking (ref.)", dgemm_avx_block},
+        {"Tile FMA simples",    dgemm_tile_padrao},
+        {"Soma compensada",     dgemm_tile_soma},
+        {"Double-double",       dgemm_tile_dd},
+    };
+    int num_methods = sizeof(methods) / sizeof(methods[0]);
+
+    printf("=== BENCHMARK DGEMM: PRECISÃO ESTENDIDA (DOUBLE-DOUBLE) ===\n");
+    printf("==========================================================\n");
+    printf("Erro relativo máximo em %d elementos de C contra __float128.\n", NUM_AMOSTRAS);
+    printf("GFLOPS nominais: 2n³ / tempo (as operações extras não contam).\n");
+
+    for (int d = 0; d < 2; d++) {
+        printf("\nDados: %s\n", datasets[d]);
+        printf("+--------+----------------------+------------+------------+---------+\n");
+        printf("| Tamanho| Método               | GFLOPS     | Erro rel.  | Custo   |\n");
+        printf("+--------+----------------------+------------+------------+---------+\n");
+
+        for (int s = 0; s < num_sizes; s++) {
+            int n = sizes[s];
+            double* A = alloc_matrix(n, "Matriz A");
+            double* B = alloc_matrix(n, "Matriz B");
+            double* C = alloc_matrix(n, "Matriz C");
+            scratch_lo = alloc_matrix(n, "C_lo");
+            if (d == 1) {
+                fill_cancellation(A, n, 1);
+                fill_cancellation(B, n, 2);
+            }
+
+            Reference ref;
+            build_reference(n, A, B, &ref);
+
+            double ops = 2.0 * (double)n * (double)n * (double)n;
+            double t_base = 0.0;
+            for (int m = 0; m < num_methods; m++) {
+                double t = run_benchmark(methods[m].func, n, A, B, C);
+                if (m == 0) t_base = t;
+                printf("| %6d | %-20s | %10.2f | %10.2e | %6.2fx |\n",
+                       n, methods[m].name, ops / t * 1e-9, max_rel_error(n, C, &ref), t / t_base);
+            }
+            if (s < num_sizes - 1) {
+                printf("+--------+----------------------+------------+------------+---------+\n");
+            }
+
+            _mm_free(A);
+            _mm_free(B);
+            _mm_free(C);
+            _mm_free(scratch_lo);
+        }
+        printf("+--------+----------------------+------------+------------+---------+\n");
+    }
+
+    printf("\nCusto = tempo / tempo do AVX+Blocking. Double-double custa ~4 FLOPs extras\n");
+    printf("por FMA e deixa o erro perto do arredondamento final (~1e-16).\n");
+
+    return 0;
+}
@@ -0,0 +1,339 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <string.h>
+#include <math.h>
+#include <immintrin.h>
+#include <stdint.h>
+#include <unistd.h>
+
+// --- CONFIGURAÇÕES ---
+#define BLOCK_SIZE 32   // Block size otimizado para L1 Cache
+#define NUM_RUNS 3      // Execuções para média estatística
+#define WARMUP_RUNS 1   // Aquecimento de cache
+
+// --- UTILITÁRIOS DE TEMPO (Alta Precisão) ---
+double get_time_sec() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// --- ALOCAÇÃO E INICIALIZAÇÃO ---
+double* alloc_matrix(int n, const char* name) {
+    double* ptr = (double*)_mm_malloc((size_t)n * n * sizeof(double), 64);
+    if (!ptr) {
+        printf("[ERRO] Falha ao alocar %s\n", name);
+        exit(1);
+    }
+
+    for (size_t i = 0; i < (size_t)n * n; i++) {
+        ptr[i] = (double)((i % 100) + 1) * 0.01;
+    }
+    return ptr;
+}
+
+void clean_matrix(double* C, int n) {
+    memset(C, 0, (size_t)n * n * sizeof(double));
+}
+
+// ============================================================
+// --- DESCRITOR DE EPÍLOGO ---
+// ============================================================
+// saida[i][j] = ativacao(alpha * C[i][j] + bias_linha[i] + bias_coluna[j])
+// Qualquer bias pode ser NULL; não precisam de alinhamento. Com saida =
+// SAIDA_F32 o resultado vai só para out_f32 e o conteúdo de C depois da
+// chamada é indefinido (no caminho fundido C é só rascunho do produto).
+typedef enum { ATIV_NENHUMA, ATIV_RELU, ATIV_CLAMP } Ativacao;
+typedef enum { SAIDA_F64, SAIDA_F32 } TipoSaida;
+
+typedef struct {
+    double alpha;
+    const double* bias_linha;   // n elementos ou NULL
+    const double* bias_coluna;  // n elementos ou NULL
+    Ativacao ativacao;
+    double clamp_min, clamp_max;
+    TipoSaida saida;
+    float* out_f32;             // Destino quando saida == SAIDA_F32
+} Epilogo;
+
+// Limites da ativação resolvidos uma vez: ReLU e clamp viram max/min
+// sem desvio no laço interno
+static void ep_limites(const Epilogo* ep, double* lo, double* hi) {
+    *lo = -INFINITY;
+    *hi = INFINITY;
+    if (ep->ativacao == ATIV_RELU) {
+        *lo = 0.0;
+    } else if (ep->ativacao == ATIV_CLAMP) {
+        *lo = ep->clamp_min;
+        *hi = ep->clamp_max;
+    }
+}
+
+// Aplica o epílogo a 4 elementos de uma linha (j múltiplo de 4)
+static inline __attribute__((always_inline))
+void ep_vec(const Epilogo* ep, __m256d v, __m256d alpha, __m256d brow,
+            __m256d lo, __m256d hi, double* C, int i, int j, int n) {
+    v = _mm256_mul_pd(v, alpha);
+    v = _mm256_add_pd(v, brow);
+    if (ep->bias_coluna) v = _mm256_add_pd(v, _mm256_loadu_pd(&ep->bias_coluna[j]));
+    v = _mm256_min_pd(_mm256_max_pd(v, lo), hi);
+    if (ep->saida == SAIDA_F32) {
+        _mm_storeu_ps(&ep->out_f32[(size_t)i * n + j], _mm256_cvtpd_ps(v));
+    } else {
+        _mm256_store_pd(&C[(size_t)i * n + j], v);
+    }
+}
+
+static inline double ep_scalar(const Epilogo* ep, double v, double brow, double lo, double hi, int j) {
+    v = v * ep->alpha + brow;
+    if (ep->bias_coluna) v += ep->bias_coluna[j];
+    if (v < lo) v = lo;
+    if (v > hi) v = hi;
+    return v;
+}
+
+static inline void ep_store_scalar(const Epilogo* ep, double v, double* C, int i, int j, int n) {
+    if (ep->saida == SAIDA_F32) ep->out_f32[(size_t)i * n + j] = (float)v;
+    else C[(size_t)i * n + j] = v;
+}
+
+// --- EPÍLOGO SEPARADO (segunda passada sobre C inteira) ---
+void epilogue_pass(int n, double* C, const Epilogo* ep) {
+    double lo_s, hi_s;
+    ep_limites(ep, &lo_s, &hi_s);
+    __m256d alpha = _mm256_set1_pd(ep->alpha);
+    __m256d lo = _mm256_set1_pd(lo_s), hi = _mm256_set1_pd(hi_s);
+
+    for (int i = 0; i < n; i++) {
+        double br = ep->bias_linha ? ep->bias_linha[i] : 0.0;
+        __m256d brow = _mm256_set1_pd(br);
+        int j = 0;
+        for (; j <= n - 4; j += 4) {
+            ep_vec(ep, _mm256_load_pd(&C[(size_t)i * n + j]), alpha, brow, lo, hi, C, i, j, n);
+        }
+        for (; j < n; j++) {
+            ep_store_scalar(ep, ep_scalar(ep, C[(size_t)i * n + j], br, lo_s, hi_s, j), C, i, j, n);
+        }
+    }
+}
+
+// ============================================================
+// --- AVX + BLOCKING COM EPÍLOGO FUNDIDO ---
+// ============================================================
+// Mesmo corpo de dgemm_avx_block, mas com os blocos na ordem i, j, k: o
+// bloco de C fica pronto ao fim do último bloco de k. Nesse último bloco a
+// iteração final de k é separada e o epílogo é aplicado nos registradores,
+// logo após o último FMA e antes do store, sem nova leitura de C.
+// Com ep == NULL é o produto puro (mesma ordem, para comparação justa).
+void dgemm_avx_block_ep(int n, double* A, double* B, double* C, const Epilogo* ep) {
+    double lo_s = 0.0, hi_s = 0.0;
+    __m256d alpha = _mm256_setzero_pd(), lo = alpha, hi = alpha;
+    if (ep) {
+        ep_limites(ep, &lo_s, &hi_s);
+        alpha = _mm256_set1_pd(ep->alpha);
+        lo = _mm256_set1_pd(lo_s);
+        hi = _mm256_set1_pd(hi_s);
+    }
+
+    for (int i_blk = 0; i_blk < n; i_blk += BLOCK_SIZE) {
+        for (int j_blk = 0; j_blk < n; j_blk += BLOCK_SIZE) {
+            for (int k_blk = 0; k_blk < n; k_blk += BLOCK_SIZE) {
+
+                int i_max = (i_blk + BLOCK_SIZE > n) ? n : i_blk + BLOCK_SIZE;
+                int k_max = (k_blk + BLOCK_SIZE > n) ? n : k_blk + BLOCK_SIZE;
+                int j_max = (j_blk + BLOCK_SIZE > n) ? n : j_blk + BLOCK_SIZE;
+                int fundir = ep && k_max == n;
+                int k_end = fundir ? k_max - 1 : k_max;
+
+                for (int i = i_blk; i < i_max; i++) {
+                    for (int k = k_blk; k < k_end; k++) {
+                        __m256d a_vec = _mm256_set1_pd(A[i * n + k]);
+
+                        int j = j_blk;
+                        #ifdef __FMA__
+                        for (; j <= j_max - 8; j += 8) {
+                            __m256d c_vec1 = _mm256_load_pd(&C[i * n + j]);
+                            __m256d b_vec1 = _mm256_load_pd(&B[k * n + j]);
+                            c_vec1 = _mm256_fmadd_pd(a_vec, b_vec1, c_vec1);
+                            _mm256_store_pd(&C[i * n + j], c_vec1);
+
+                            __m256d c_vec2 = _mm256_load_pd(&C[i * n + j + 4]);
+                            __m256d b_vec2 = _mm256_load_pd(&B[k * n + j + 4]);
+                            c_vec2 = _mm256_fmadd_pd(a_vec, b_vec2, c_vec2);
+                            _mm256_store_pd(&C[i * n + j + 4], c_vec2);
+                        }
+                        #endif
+
+                        for (; j <= j_max - 4; j += 4) {
+                            __m256d c_vec = _mm256_load_pd(&C[i * n + j]);
+                            __m256d b_vec = _mm256_load_pd(&B[k * n + j]);
+                            #ifdef __FMA__
+                            c_vec = _mm256_fmadd_pd(a_vec, b_vec, c_vec);
+                            #else
+                            c_vec = _mm256_add_pd(c_vec, _mm256_mul_pd(a_vec, b_vec));
+                            #endif
+                            _mm256_store_pd(&C[i * n + j], c_vec);
+                        }
+
+                        for (; j < j_max; j++) {
+                            C[i * n + j] += A[i * n + k] * B[k * n + j];
+                        }
+                    }
+
+                    if (!fundir) continue;
+
+                    // Última iteração de k: FMA + epílogo nos registradores
+                    int k = n - 1;
+                    double br = ep->bias_linha ? ep->bias_linha[i] : 0.0;
+                    __m256d brow = _mm256_set1_pd(br);
+                    __m256d a_vec = _mm256_set1_pd(A[i * n + k]);
+                    int j = j_blk;
+                    for (; j <= j_max - 4; j += 4) {
+                        __m256d c_vec = _mm256_load_pd(&C[i * n + j]);
+                        __m256d b_vec = _mm256_load_pd(&B[k * n + j]);
+                        #ifdef __FMA__
+                        c_vec = _mm256_fmadd_pd(a_vec, b_vec, c_vec);
+                        #else
+                        c_vec = _mm256_add_pd(c_vec, _mm256_mul_pd(a_vec, b_vec));
+                        #endif
+                        ep_vec(ep, c_vec, alpha, brow, lo, hi, C, i, j, n);
+                    }
+                    for (; j < j_max; j++) {
+                        double v = C[i * n + j] + A[i * n + k] * B[k * n + j];
+                        ep_store_scalar(ep, ep_scalar(ep, v, br, lo_s, hi_s, j), C, i, j, n);
+                    }
+                }
+            }
+        }
+    }
+}
+
+// --- VERSÕES COMPARADAS ---
+void run_unfused(int n, double* A, double* B, double* C, const Epilogo* ep) {
+    dgemm_avx_block_ep(n, A, B, C, NULL);
+    epilogue_pass(n, C, ep);
+}
+
+void run_fused(int n, double* A, double* B, double* C, const Epilogo* ep) {
+    dgemm_avx_block_ep(n, A, B, C, ep);
+}
+
+// Tempo médio de NUM_RUNS execuções (C zerada antes de cada uma)
+double time_variant(void (*func)(int, double*, double*, double*, const Epilogo*),
+                    int n, double* A, double* B, double* C, const Epilogo* ep) {
+    for (int w = 0; w < WARMUP_RUNS; w++) {
+        clean_matrix(C, n);
+        func(n, A, B, C, ep);
+    }
+    double total = 0.0;
+    for (int r = 0; r < NUM_RUNS; r++) {
+        clean_matrix(C, n);
+        double start = get_time_sec();
+        func(n, A, B, C, ep);
+        total += get_time_sec() - start;
+    }
+    return total / NUM_RUNS;
+}
+
+// Tempo da passada isolada sobre um C já calculado
+double time_pass(int n, double* C, const Epilogo* ep) {
+    double* tmp = alloc_matrix(n, "Cópia de C");
+    double total = 0.0;
+    for (int r = 0; r < NUM_RUNS; r++) {
+        memcpy(tmp, C, (size_t)n * n * sizeof(double));
+        double start = get_time_sec();
+        epilogue_pass(n, tmp, ep);
+        total += get_time_sec() - start;
+    }
+    _mm_free(tmp);
+    return total / NUM_RUNS;
+}
+
+// Maior diferença relativa entre os resultados fundido e não fundido
+double compare_outputs(int n, const double* C1, const double* C2, const float* F1, const float* F2) {
+    double max_err = 0.0;
+    for (size_t i = 0; i < (size_t)n * n; i++) {
+        double a = F1 ? F1[i] : C1[i];
+        double b = F2 ? F2[i] : C2[i];
+        double err = fabs(a - b) / (fabs(b) > 1.0 ? fabs(b) : 1.0);
+        if (err > max_err) max_err = err;
+    }
+    return max_err;
+}
+
+int main() {
+    int sizes[] = {256, 512, 1024, 2048};
+    int num_sizes = sizeof(sizes) / sizeof(sizes[0]);
+
+    printf("=== EPÍLOGO FUNDIDO: BIAS + ALPHA + ATIVAÇÃO + CONVERSÃO ===\n");
+    printf("==========================================================\n");
+    printf("Não fundido: produto AVX+Blocking e depois uma passada sobre C\n");
+    printf("Fundido:     epílogo aplicado nos registradores no último FMA de cada bloco\n\n");
+
+    printf("+-------+------------------------+-------------+-------------+-------------+---------+----------+\n");
+    printf("|   N   | Epílogo                | Passada (s) | Separado(s) | Fundido (s) | Speedup | Erro máx |\n");
+    printf("+-------+------------------------+-------------+-------------+-------------+---------+----------+\n");
+
+    for (int s = 0; s < num_sizes; s++) {
+        int n = sizes[s];
+        double* A = alloc_matrix(n, "Matriz A");
+        double* B = alloc_matrix(n, "Matriz B");
+        double* C1 = alloc_matrix(n, "Matriz C (separado)");
+        double* C2 = alloc_matrix(n, "Matriz C (fundido)");
+        double* bias_l = (double*)_mm_malloc(n * sizeof(double), 64);
+        double* bias_c = (double*)_mm_malloc(n * sizeof(double), 64);
+        float* F1 = (float*)_mm_malloc((size_t)n * n * sizeof(float), 64);
+        float* F2 = (float*)_mm_malloc((size_t)n * n * sizeof(float), 64);
+        if (!bias_l || !bias_c || !F1 || !F2) {
+            printf("[ERRO] Falha ao alocar bias/saída\n");
+            exit(1);
+        }
+
+        // Bias negativos o bastante para a ReLU/clamp cortarem parte de C
+        for (int i = 0; i < n; i++) {
+            bias_l[i] = -0.25 * n * ((i % 7) * 0.1);
+            bias_c[i] = -0.25 * n * ((i % 5) * 0.1);
+        }
+
+        Epilogo configs[2] = {
+            {0.5, bias_l, bias_c, ATIV_RELU, 0.0, 0.0, SAIDA_F64, NULL},
+            {0.5, bias_l, NULL, ATIV_CLAMP, -1.0 * n, 1.0 * n, SAIDA_F32, NULL},
+        };
+        const char* names[2] = {"bias L+C, a, ReLU, f64", "bias L, a, clamp, f32"};
+
+        for (int c = 0; c < 2; c++) {
+            Epilogo ep1 = configs[c], ep2 = configs[c];
+            if (ep1.saida == SAIDA_F32) {
+                ep1.out_f32 = F1;
+                ep2.out_f32 = F2;
+            }
+
+            double t_sep = time_variant(run_unfused, n, A, B, C1, &ep1);
+            double t_fus = time_variant(run_fused, n, A, B, C2, &ep2);
+
+            // Passada isolada: mede sobre o produto sem epílogo
+            clean_matrix(C1, n);
+            dgemm_avx_block_ep(n, A, B, C1, NULL);
+            double t_pass = time_pass(n, C1, &ep1);
+
+            // Resultado de referência (separado) para conferir o fundido
+            epilogue_pass(n, C1, &ep1);
+            double err = (ep1.saida == SAIDA_F32)
+                ? compare_outputs(n, NULL, NULL, F2, F1)
+                : compare_outputs(n, C2, C1, NULL, NULL);
+
+            printf("| %5d | %-22s | %11.6f | %11.4f | %11.4f | %6.3fx | %8.1e |\n",
+                   n, names[c], t_pass, t_sep, t_fus, t_sep / t_fus, err);
+        }
+
+        _mm_free(A); _mm_free(B); _mm_free(C1); _mm_free(C2);
+        _mm_free(bias_l); _mm_free(bias_c); _mm_free(F1); _mm_free(F2);
+    }
+    printf("+-------+------------------------+-------------+-------------+-------------+---------+----------+\n");
+    printf("\nPassada = custo isolado da segunda leitura/escrita de C (o que o fundido elimina)\n");
+    printf("Em N=2048 a passada relê %.0f MB de C; o ganho relativo cai com N\n",
+           2048.0 * 2048 * sizeof(double) / (1024 * 1024));
+    printf("porque o produto cresce com N³ e a passada com N².\n");
+    return 0;
+}
@@ -0,0 +1,404 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <string.h>
+#include <immintrin.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <pthread.h>
+
+// --- CONFIGURAÇÕES ---
+#define BLOCK_SIZE 32           // Block size do caminho geral
+#define SKINNY_MAX_N 16         // Até este número de colunas de B usa o kernel magro
+#define MAX_THREADS 64          // Limite de threads por linha de A
+#define BW_BUFFER_MB 256        // Buffer do teste de banda de memória
+#define NUM_RUNS 5              // Execuções para média estatística
+#define WARMUP_RUNS 1           // Aquecimento de cache
+
+// --- UTILITÁRIOS DE TEMPO (Alta Precisão) ---
+double get_time_sec() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// --- ALOCAÇÃO E INICIALIZAÇÃO (retangular) ---
+double* alloc_rect(int rows, int cols, const char* name) {
+    double* ptr = (double*)_mm_malloc((size_t)rows * cols * sizeof(double), 64);
+    if (!ptr) {
+        printf("[ERRO] Falha ao alocar %s\n", name);
+        exit(1);
+    }
+
+    for (size_t i = 0; i < (size_t)rows * cols; i++) {
+        ptr[i] = (double)((i % 100) + 1) * 0.01;
+    }
+    return ptr;
+}
+
+static inline __m256d fma_pd(__m256d a, __m256d b, __m256d c) {
+    #ifdef __FMA__
+    return _mm256_fmadd_pd(a, b, c);
+    #else
+    return _mm256_add_pd(c, _mm256_mul_pd(a, b));
+    #endif
+}
+
+static inline double hsum_pd(__m256d v) {
+    __m128d lo = _mm256_castpd256_pd128(v);
+    __m128d hi = _mm256_extractf128_pd(v, 1);
+    lo = _mm_add_pd(lo, hi);
+    return _mm_cvtsd_f64(_mm_add_sd(lo, _mm_unpackhi_pd(lo, lo)));
+}
+
+// --- CAMINHO GERAL: AVX + BLOCKING (retangular) ---
+// C[m x n] += A[m x k] * B[k x n]
+void dgemm_avx_block_rect(int m, int k, int n, const double* A, const double* B, double* C,
+                          int row_begin, int row_end) {
+    for (int i_blk = row_begin; i_blk < row_end; i_blk += BLOCK_SIZE) {
+        for (int k_blk = 0; k_blk < k; k_blk += BLOCK_SIZE) {
+            for (int j_blk = 0; j_blk < n; j_blk += BLOCK_SIZE) {
+                int i_max = (i_blk + BLOCK_SIZE > row_end) ? row_end : i_blk + BLOCK_SIZE;
+                int k_max = (k_blk + BLOCK_SIZE > k) ? k : k_blk + BLOCK_SIZE;
+                int j_max = (j_blk + BLOCK_SIZE > n) ? n : j_blk + BLOCK_SIZE;
+
+                for (int i = i_blk; i < i_max; i++) {
+                    for (int kk = k_blk; kk < k_max; kk++) {
+                        __m256d a_vec = _mm256_set1_pd(A[(size_t)i * k + kk]);
+                        int j = j_blk;
+                        for (; j <= j_max - 4; j += 4) {
+                            __m256d c_vec = _mm256_loadu_pd(&C[(size_t)i * n + j]);
+                            __m256d b_vec = _mm256_loadu_pd(&B[(size_t)kk * n + j]);
+                            _mm256_storeu_pd(&C[(size_t)i * n + j], fma_pd(a_vec, b_vec, c_vec));
+                        }
+                        for (; j < j_max; j++) {
+                            C[(size_t)i * n + j] += A[(size_t)i * k + kk] * B[(size_t)kk * n + j];
+                        }
+                    }
+                }
+            }
+        }
+    }
+    (void)m;
+}
+
+// --- DGEMV: y[m] += A[m x k] * x[k] ---
+// A é lido uma única vez, 16 doubles por iteração em 4 acumuladores
+// independentes (esconde a latência do FMA); x fica na cache.
+void dgemv_rows(int k, const double* A, const double* x, double* y, int row_begin, int row_end) {
+    for (int i = row_begin; i < row_end; i++) {
+        const double* a = &A[(size_t)i * k];
+        __m256d acc0 = _mm256_setzero_pd();
+        __m256d acc1 = _mm256_setzero_pd();
+        __m256d acc2 = _mm256_setzero_pd();
+        __m256d acc3 = _mm256_setzero_pd();
+
+        int j = 0;
+        for (; j <= k - 16; j += 16) {
+            acc0 = fma_pd(_mm256_loadu_pd(&a[j]),      _mm256_loadu_pd(&x[j]),      acc0);
+            acc1 = fma_pd(_mm256_loadu_pd(&a[j + 4]),  _mm256_loadu_pd(&x[j + 4]),  acc1);
+            acc2 = fma_pd(_mm256_loadu_pd(&a[j + 8]),  _mm256_loadu_pd(&x[j + 8]),  acc2);
+            acc3 = fma_pd(_mm256_loadu_pd(&a[j + 12]), _mm256_loadu_pd(&x[j + 12]), acc3);
+        }
+        for (; j <= k - 4; j += 4) {
+            acc0 = fma_pd(_mm256_loadu_pd(&a[j]), _mm256_loadu_pd(&x[j]), acc0);
+        }
+
+        double sum = hsum_pd(_mm256_add_pd(_mm256_add_pd(acc0, acc1), _mm256_add_pd(acc2, acc3)));
+        for (; j < k; j++) sum += a[j] * x[j];
+        y[i] += sum;
+    }
+}
+
+// --- TALL-SKINNY: C[m x n] += A[m x k] * B[k x n], n <= 16 ---
+// B (k x n) é pequeno e fica na cache; A é lido uma vez. Cada tile cobre
+// R linhas x NV vetores com R*NV = 8 acumuladores (cadeias de FMA
+// independentes suficientes para esconder a latência). Colunas que sobram
+// de 4 usam maskload/maskstore em vez de laço escalar.
+static inline __attribute__((always_inline))
+void skinny_tile(int R, int NV, int k, int n, const double* A, const double* B, double* C,
+                 __m256i mask) {
+    __m256i full = _mm256_set1_epi64x(-1);
+    __m256d acc[8];
+    for (int t = 0; t < R * NV; t++) acc[t] = _mm256_setzero_pd();
+
+    for (int kk = 0; kk < k; kk++) {
+        const double* b = &B[(size_t)kk * n];
+        __m256d bv[4];
+        for (int v = 0; v < NV; v++) {
+            bv[v] = _mm256_maskload_pd(&b[v * 4], (v == NV - 1) ? mask : full);
+        }
+        for (int r = 0; r < R; r++) {
+            __m256d x = _mm256_broadcast_sd(&A[(size_t)r * k + kk]);
+            for (int v = 0; v < NV; v++) acc[r * NV + v] = fma_pd(x, bv[v], acc[r * NV + v]);
+        }
+    }
+
+    for (int r = 0; r < R; r++) {
+        for (int v = 0; v < NV; v++) {
+            __m256i mv = (v == NV - 1) ? mask : full;
+            double* c = &C[(size_t)r * n + v * 4];
+            _mm256_maskstore_pd(c, mv, _mm256_add_pd(_mm256_maskload_pd(c, mv), acc[r * NV + v]));
+        }
+    }
+}
+
+#define SKINNY_CASE(R, NV) \
+    for (; i <= row_end - (R); i += (R)) \
+        skinny_tile(R, NV, k, n, &A[(size_t)i * k], B, &C[(size_t)i * n], mask)
+
+void dgemm_skinny_rows(int k, int n, const double* A, const double* B, double* C,
+                       int row_begin, int row_end) {
+    int nv = (n + 3) / 4;
+    int tail = n % 4;
+    __m256i mask = tail ? _mm256_setr_epi64x(-1, tail > 1 ? -1 : 0, tail > 2 ? -1 : 0, 0)
+                        : _mm256_set1_epi64x(-1);
+
+    int i = row_begin;
+    switch (nv) {
+        case 1: SKINNY_CASE(8, 1); break;
+        case 2: SKINNY_CASE(4, 2); break;
+        case 3: SKINNY_CASE(2, 3); break;
+        default: SKINNY_CASE(2, 4); break;
+    }
+
+    for (; i < row_end; i++) {
+        for (int kk = 0; kk < k; kk++) {
+            double a = A[(size_t)i * k + kk];
+            for (int j = 0; j < n; j++) C[(size_t)i * n + j] += a * B[(size_t)kk * n + j];
+        }
+    }
+}
+
+// --- PARALELISMO POR LINHAS ---
+typedef enum { PATH_GERAL = 0, PATH_GEMV = 1, PATH_SKINNY = 2 } GemmPath;
+
+typedef struct {
+    GemmPath path;
+    int m, k, n;
+    const double* A;
+    const double* B;
+    double* C;
+    int row_begin, row_end;
+} RowTask;
+
+static void* row_worker(void* arg) {
+    RowTask* t = (RowTask*)arg;
+    switch (t->path) {
+        case PATH_GEMV:
+            dgemv_rows(t->k, t->A, t->B, t->C, t->row_begin, t->row_end);
+            break;
+        case PATH_SKINNY:
+            dgemm_skinny_rows(t->k, t->n, t->A, t->B, t->C, t->row_begin, t->row_end);
+            break;
+        default:
+            dgemm_avx_block_rect(t->m, t->k, t->n, t->A, t->B, t->C, t->row_begin, t->row_end);
+            break;
+    }
+    return NULL;
+}
+
+static int num_threads = 1;
+
+// Divide as linhas de A em faixas contíguas (múltiplas de BLOCK_SIZE)
+void run_rows(GemmPath path, int m, int k, int n, const double* A, const double* B, double* C) {
+    pthread_t threads[MAX_THREADS];
+    RowTask tasks[MAX_THREADS];
+    int nt = num_threads;
+    int chunk = (m + nt - 1) / nt;
+    chunk = (chunk + BLOCK_SIZE - 1) / BLOCK_SIZE * BLOCK_SIZE;
+
+    int used = 0;
+    for (int t = 0; t < nt; t++) {
+        int begin = t * chunk;
+        if (begin >= m) break;
+        int end = (begin + chunk > m) ? m : begin + chunk;
+        tasks[t] = (RowTask){path, m, k, n, A, B, C, begin, end};
+        used++;
+    }
+
+    // Se a thread não puder ser criada, a faixa roda aqui mesmo (nenhuma linha de C fica sem cálculo)
+    int started[MAX_THREADS] = {0};
+    for (int t = 1; t < used; t++) {
+        if (pthread_create(&threads[t], NULL, row_worker, &tasks[t]) == 0) started[t] = 1;
+        else row_worker(&tasks[t]);
+    }
+    if (used > 0) row_worker(&tasks[0]);
+    for (int t = 1; t < used; t++) {
+        if (started[t]) pthread_join(threads[t], NULL);
+    }
+}
+
+// --- DESPACHO POR FORMA ---
+GemmPath choose_path(int n) {
+    if (n == 1) return PATH_GEMV;
+    if (n <= SKINNY_MAX_N) return PATH_SKINNY;
+    return PATH_GERAL;
+}
+
+void dgemm_dispatch(int m, int k, int n, const double* A, const double* B, double* C) {
+    run_rows(choose_path(n), m, k, n, A, B, C);
+}
+
+void dgemm_general(int m, int k, int n, const double* A, const double* B, double* C) {
+    run_rows(PATH_GERAL, m, k, n, A, B, C);
+}
+
+// --- TETO DE BANDA DE MEMÓRIA ---
+// Soma paralela de um buffer muito maior que a L3 (somente leitura,
+// como o acesso a A nos kernels acima)
+typedef struct {
+    const double* p;
+    size_t begin, end;
+    double sum;
+} BwTask;
+
+static void* bw_worker(void* arg) {
+    BwTask* t = (BwTask*)arg;
+    __m256d s0 = _mm256_setzero_pd(), s1 = _mm256_setzero_pd();
+    __m256d s2 = _mm256_setzero_pd(), s3 = _mm256_setzero_pd();
+    for (size_t i = t->begin; i < t->end; i += 16) {
+        s0 = _mm256_add_pd(s0, _mm256_load_pd(&t->p[i]));
+        s1 = _mm256_add_pd(s1, _mm256_load_pd(&t->p[i + 4]));
+        s2 = _mm256_add_pd(s2, _mm256_load_pd(&t->p[i + 8]));
+        s3 = _mm256_add_pd(s3, _mm256_load_pd(&t->p[i + 12]));
+    }
+    t->sum = hsum_pd(_mm256_add_pd(_mm256_add_pd(s0, s1), _mm256_add_pd(s2, s3)));
+    return NULL;
+}
+
+double measure_read_bandwidth(void) {
+    size_t count = (size_t)BW_BUFFER_MB * 1024 * 1024 / sizeof(double);
+    double* buf = (double*)_mm_malloc(count * sizeof(double), 64);
+    if (!buf) {
+        printf("[ERRO] Falha ao alocar buffer de banda\n");
+        exit(1);
+    }
+    for (size_t i = 0; i < count; i++) buf[i] = 1.0;
+
+    pthread_t threads[MAX_THREADS];
+    BwTask tasks[MAX_THREADS];
+    size_t chunk = count / num_threads / 16 * 16;
+    double best = 1e9;
+
+    for (int r = 0; r < NUM_RUNS; r++) {
+        double start = get_time_sec();
+        for (int t = 0; t < num_threads; t++) {
+            tasks[t].p = buf;
+            tasks[t].begin = t * chunk;
+            tasks[t].end = (t == num_threads - 1) ? count / 16 * 16 : (t + 1) * chunk;
+            if (t > 0 && pthread_create(&threads[t], NULL, bw_worker, &tasks[t]) != 0) {
+                printf("[ERRO] Falha ao criar thread %d da medição de banda\n", t);
+                exit(1);
+            }
+        }
+        bw_worker(&tasks[0]);
+        for (int t = 1; t < num_threads; t++) pthread_join(threads[t], NULL);
+        double elapsed = get_time_sec() - start;
+        if (elapsed < best) best = elapsed;
+    }
+
+    _mm_free(buf);
+    return (double)count * sizeof(double) / best * 1e-9;
+}
+
+// --- BENCHMARK ---
+typedef void (*GemmFn)(int, int, int, const double*, const double*, double*);
+
+double run_benchmark(GemmFn func, int m, int k, int n, const double* A, const double* B, double* C) {
+    for (int w = 0; w < WARMUP_RUNS; w++) {
+        memset(C, 0, (size_t)m * n * sizeof(double));
+        func(m, k, n, A, B, C);
+    }
+
+    double best = 1e9;
+    for (int r = 0; r < NUM_RUNS; r++) {
+        memset(C, 0, (size_t)m * n * sizeof(double));
+        double start = get_time_sec();
+        func(m, k, n, A, B, C);
+        double elapsed = get_time_sec() - start;
+        if (elapsed < best) best = elapsed;
+    }
+    return best;
+}
+
+double max_abs_diff(const double* X, const double* Y, size_t count) {
+    double diff = 0.0;
+    for (size_t i = 0; i < count; i++) {
+        double d = X[i] - Y[i];
+        if (d < 0) d = -d;
+        if (d > diff) diff = d;
+    }
+    return diff;
+}
+
+int main() {
+    num_threads = sysconf(_SC_NPROCESSORS_ONLN);
+    if (num_threads > MAX_THREADS) num_threads = MAX_THREADS;
+    if (num_threads < 1) num_threads = 1;
+
+    // Formas: m x k (A) e n colunas em B
+    int shapes[][3] = {
+        {4096, 4096, 1},
+        {16384, 2048, 1},
+        {32768, 512, 1},
+        {32768, 512, 4},
+        {32768, 512, 7},
+        {32768, 512, 8},
+        {32768, 512, 16},
+        {4096, 4096, 16},
+    };
+    int num_shapes = sizeof(shapes) / sizeof(shapes[0]);
+    const char* path_names[] = {"geral", "gemv", "magro"};
+
+    printf("=== BENCHMARK: DGEMV / TALL-SKINNY (LIMITADOS POR MEMÓRIA) ===\n");
+    printf("==========================================================\n");
+    printf("Threads (por linhas): %d\n", num_threads);
+    double bw_peak = measure_read_bandwidth();
+    printf("Teto de banda medido: %.2f GB/s (leitura de %d MB)\n\n", bw_peak, BW_BUFFER_MB);
+
+    printf("+--------------------+-------+------------+------------+------------+------------+--------+\n");
+    printf("| Forma (m x k x n)  | Path  | Geral      | Despachado | Despachado | %% do teto  | Ganho  |\n");
+    printf("|                    |       | (GB/s)     | (GB/s)     | (GFLOPS)   |            |        |\n");
+    printf("+--------------------+-------+------------+------------+------------+------------+--------+\n");
+
+    for (int s = 0; s < num_shapes; s++) {
+        int m = shapes[s][0], k = shapes[s][1], n = shapes[s][2];
+        double* A = alloc_rect(m, k, "Matriz A");
+        double* B = alloc_rect(k, n, "Matriz B");
+        double* C = alloc_rect(m, n, "Matriz C");
+        double* C_ref = alloc_rect(m, n, "Matriz C_ref");
+
+        memset(C_ref, 0, (size_t)m * n * sizeof(double));
+        dgemm_general(m, k, n, A, B, C_ref);
+        memset(C, 0, (size_t)m * n * sizeof(double));
+        dgemm_dispatch(m, k, n, A, B, C);
+        double err = max_abs_diff(C, C_ref, (size_t)m * n);
+        if (err > 1e-9 * k) {
+            printf("[ERRO] Divergência em %dx%dx%d (erro %.2e)\n", m, k, n, err);
+        }
+
+        double t_gen = run_benchmark(dgemm_general, m, k, n, A, B, C);
+        double t_disp = run_benchmark(dgemm_dispatch, m, k, n, A, B, C);
+
+        // Tráfego mínimo: A uma vez, B uma vez, C lido e escrito
+        double bytes = ((double)m * k + (double)k * n + 2.0 * m * n) * sizeof(double);
+        double flops = 2.0 * (double)m * k * n;
+        double bw_gen = bytes / t_gen * 1e-9;
+        double bw_disp = bytes / t_disp * 1e-9;
+
+        printf("| %5d x %5d x %2d | %-5s | %10.2f | %10.2f | %10.2f | %9.1f%% | %5.2fx |\n",
+               m, k, n, path_names[choose_path(n)], bw_gen, bw_disp, flops / t_disp * 1e-9,
+               bw_disp / bw_peak * 100.0, t_gen / t_disp);
+
+        _mm_free(A);
+        _mm_free(B);
+        _mm_free(C);
+        _mm_free(C_ref);
+    }
+    printf("+--------------------+-------+------------+------------+------------+------------+--------+\n");
+    printf("\nGB/s calculado sobre o tráfego mínimo (A e B lidos uma vez, C lido e escrito).\n");
+    printf("Acima de %d colunas o despacho volta ao caminho geral com blocking.\n", SKINNY_MAX_N);
+
+    return 0;
+}
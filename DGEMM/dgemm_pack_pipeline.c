@@ -0,0 +1,465 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <string.h>
+#include <immintrin.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sched.h>
+
+// --- CONFIGURAÇÕES ---
+#define BLOCK_SIZE 32       // Block size do kernel de referência
+#define KC 256              // Linhas de B por painel empacotado
+#define NC 512              // Colunas de B por painel empacotado
+#define MR 4                // Linhas do micro-kernel
+#define NR 8                // Colunas do micro-kernel (2 vetores AVX)
+#define PACK_HELPER_CPU -1  // CPU da thread de pack (-1 = irmão SMT da thread de cálculo, -2 = livre)
+#define NUM_RUNS 5          // Execuções para média estatística
+#define WARMUP_RUNS 1       // Aquecimento de cache
+
+// --- UTILITÁRIOS DE TEMPO (Alta Precisão) ---
+double get_time_sec() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// --- ALOCAÇÃO E INICIALIZAÇÃO ---
+double* alloc_matrix(int n, const char* name) {
+    double* ptr = (double*)_mm_malloc(n * n * sizeof(double), 64);
+    if (!ptr) {
+        printf("[ERRO] Falha ao alocar %s\n", name);
+        exit(1);
+    }
+
+    for (int i = 0; i < n * n; i++) {
+        ptr[i] = (double)((i % 100) + 1) * 0.01;
+    }
+    return ptr;
+}
+
+void clean_matrix(double* C, int n) {
+    memset(C, 0, n * n * sizeof(double));
+}
+
+// --- REFERÊNCIA: AVX + BLOCKING (dgemm_aprimorado_2.c) ---
+void dgemm_avx_block(int n, double* A, double* B, double* C) {
+    for (int i_blk = 0; i_blk < n; i_blk += BLOCK_SIZE) {
+        for (int k_blk = 0; k_blk < n; k_blk += BLOCK_SIZE) {
+            for (int j_blk = 0; j_blk < n; j_blk += BLOCK_SIZE) {
+
+                int i_max = (i_blk + BLOCK_SIZE > n) ? n : i_blk + BLOCK_SIZE;
+                int k_max = (k_blk + BLOCK_SIZE > n) ? n : k_blk + BLOCK_SIZE;
+                int j_max = (j_blk + BLOCK_SIZE > n) ? n : j_blk + BLOCK_SIZE;
+
+                for (int i = i_blk; i < i_max; i++) {
+                    for (int k = k_blk; k < k_max; k++) {
+                        __m256d a_vec = _mm256_set1_pd(A[i * n + k]);
+                        int j = j_blk;
+                        for (; j <= j_max - 4; j += 4) {
+                            __m256d c_vec = _mm256_loadu_pd(&C[i * n + j]);
+                            __m256d b_vec = _mm256_loadu_pd(&B[k * n + j]);
+                            #ifdef __FMA__
+                            c_vec = _mm256_fmadd_pd(a_vec, b_vec, c_vec);
+                            #else
+                            c_vec = _mm256_add_pd(c_vec, _mm256_mul_pd(a_vec, b_vec));
+                            #endif
+                            _mm256_storeu_pd(&C[i * n + j], c_vec);
+                        }
+                        for (; j < j_max; j++) {
+                            C[i * n + j] += A[i * n + k] * B[k * n + j];
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+// --- EMPACOTAMENTO DE B ---
+// Painel kc x nc vira fatias de NR colunas contíguas: para cada fatia,
+// kc linhas de NR doubles (bordas completadas com zero). O micro-kernel
+// lê B sequencialmente e alinhado em vez de pular n doubles por linha.
+void pack_b_panel(int n, const double* B, int pc, int jc, int kc, int nc, double* Bp) {
+    for (int js = 0; js < nc; js += NR) {
+        int nr = (nc - js < NR) ? nc - js : NR;
+        for (int k = 0; k < kc; k++) {
+            const double* src = &B[(pc + k) * n + jc + js];
+            if (nr == NR) {
+                _mm256_store_pd(&Bp[0], _mm256_loadu_pd(&src[0]));
+                _mm256_store_pd(&Bp[4], _mm256_loadu_pd(&src[4]));
+            } else {
+                for (int j = 0; j < NR; j++) Bp[j] = (j < nr) ? src[j] : 0.0;
+            }
+            Bp += NR;
+        }
+    }
+}
+
+// --- MICRO-KERNEL MR x NR SOBRE B EMPACOTADO ---
+static inline __m256d fma_pd(__m256d a, __m256d b, __m256d c) {
+    #ifdef __FMA__
+    return _mm256_fmadd_pd(a, b, c);
+    #else
+    return _mm256_add_pd(c, _mm256_mul_pd(a, b));
+    #endif
+}
+
+void micro_kernel(int n, int kc, int mr, int nr, const double* A, const double* Bp, double* C) {
+    // Linhas além de mr repetem a linha 0 (resultado descartado)
+    const double* a0 = A;
+    const double* a1 = (mr > 1) ? A + n : A;
+    const double* a2 = (mr > 2) ? A + 2 * n : A;
+    const double* a3 = (mr > 3) ? A + 3 * n : A;
+
+    __m256d c00 = _mm256_setzero_pd(), c01 = _mm256_setzero_pd();
+    __m256d c10 = _mm256_setzero_pd(), c11 = _mm256_setzero_pd();
+    __m256d c20 = _mm256_setzero_pd(), c21 = _mm256_setzero_pd();
+    __m256d c30 = _mm256_setzero_pd(), c31 = _mm256_setzero_pd();
+
+    for (int k = 0; k < kc; k++) {
+        __m256d b0 = _mm256_load_pd(&Bp[k * NR]);
+        __m256d b1 = _mm256_load_pd(&Bp[k * NR + 4]);
+        __m256d a;
+        a = _mm256_broadcast_sd(&a0[k]); c00 = fma_pd(a, b0, c00); c01 = fma_pd(a, b1, c01);
+        a = _mm256_broadcast_sd(&a1[k]); c10 = fma_pd(a, b0, c10); c11 = fma_pd(a, b1, c11);
+        a = _mm256_broadcast_sd(&a2[k]); c20 = fma_pd(a, b0, c20); c21 = fma_pd(a, b1, c21);
+        a = _mm256_broadcast_sd(&a3[k]); c30 = fma_pd(a, b0, c30); c31 = fma_pd(a, b1, c31);
+    }
+
+    __m256d acc[MR][2] = {{c00, c01}, {c10, c11}, {c20, c21}, {c30, c31}};
+    if (mr == MR && nr == NR) {
+        for (int r = 0; r < MR; r++) {
+            double* c = &C[r * n];
+            _mm256_storeu_pd(&c[0], _mm256_add_pd(_mm256_loadu_pd(&c[0]), acc[r][0]));
+            _mm256_storeu_pd(&c[4], _mm256_add_pd(_mm256_loadu_pd(&c[4]), acc[r][1]));
+        }
+    } else {
+        double tile[NR] __attribute__((aligned(32)));
+        for (int r = 0; r < mr; r++) {
+            _mm256_store_pd(&tile[0], acc[r][0]);
+            _mm256_store_pd(&tile[4], acc[r][1]);
+            for (int j = 0; j < nr; j++) C[r * n + j] += tile[j];
+        }
+    }
+}
+
+// Calcula C[:, jc:jc+nc] += A[:, pc:pc+kc] * painel
+void compute_panel(int n, const double* A, const double* Bp, double* C,
+                   int pc, int jc, int kc, int nc) {
+    for (int i = 0; i < n; i += MR) {
+        int mr = (n - i < MR) ? n - i : MR;
+        for (int js = 0; js < nc; js += NR) {
+            int nr = (nc - js < NR) ? nc - js : NR;
+            micro_kernel(n, kc, mr, nr, &A[i * n + pc], &Bp[js * kc], &C[i * n + jc + js]);
+        }
+    }
+}
+
+// --- INSTRUMENTAÇÃO ---
+typedef struct {
+    double pack_time;       // Tempo total gasto empacotando
+    double wait_time;       // Tempo em que o cálculo ficou parado esperando painel
+    double total_time;
+    int panels;
+} PackStats;
+
+static PackStats last_stats;
+
+// --- VERSÃO SERIAL: empacota e depois calcula ---
+void dgemm_packed_serial(int n, double* A, double* B, double* C) {
+    double* Bp = (double*)_mm_malloc((size_t)KC * (NC + NR) * sizeof(double), 64);
+    if (!Bp) {
+        printf("[ERRO] Falha ao alocar buffer de empacotamento\n");
+        exit(1);
+    }
+    PackStats st = {0};
+    double t_start = get_time_sec();
+
+    for (int jc = 0; jc < n; jc += NC) {
+        int nc = (n - jc < NC) ? n - jc : NC;
+        for (int pc = 0; pc < n; pc += KC) {
+            int kc = (n - pc < KC) ? n - pc : KC;
+            double t0 = get_time_sec();
+            pack_b_panel(n, B, pc, jc, kc, nc, Bp);
+            double t1 = get_time_sec();
+            st.pack_time += t1 - t0;
+            st.wait_time += t1 - t0;   // Nada escondido: cálculo espera todo o empacotamento
+            compute_panel(n, A, Bp, C, pc, jc, kc, nc);
+            st.panels++;
+        }
+    }
+
+    st.total_time = get_time_sec() - t_start;
+    last_stats = st;
+    _mm_free(Bp);
+}
+
+// --- VERSÃO PIPELINE (Double Buffer) ---
+// A thread auxiliar empacota o painel p+1 em buf[(p+1)%2] enquanto o
+// cálculo usa buf[p%2]. filled[b] guarda o índice do painel presente no
+// buffer b (-1 = livre para ser reescrito).
+typedef struct {
+    int n;
+    const double* B;
+    double* buf[2];
+    int filled[2];
+    int num_panels;
+    int helper_cpu;     // CPU onde a thread de pack se fixa (-1 = sem afinidade)
+    double pack_time;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+} PackPipeline;
+
+static void panel_coords(int n, int p, int* pc, int* jc, int* kc, int* nc) {
+    int k_panels = (n + KC - 1) / KC;
+    *jc = (p / k_panels) * NC;
+    *pc = (p % k_panels) * KC;
+    *nc = (n - *jc < NC) ? n - *jc : NC;
+    *kc = (n - *pc < KC) ? n - *pc : KC;
+}
+
+// Irmão SMT de cpu (outra CPU lógica do mesmo núcleo físico), lido do
+// sysfs no formato "0,32" ou "0-1"; -1 se não houver
+static int smt_sibling(int cpu) {
+    char path[128], line[256];
+    snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/topology/thread_siblings_list", cpu);
+    FILE* f = fopen(path, "r");
+    if (!f) return -1;
+    int ok = fgets(line, sizeof(line), f) != NULL;
+    fclose(f);
+    if (!ok) return -1;
+
+    char* p = line;
+    while (1) {
+        char* end;
+        long a = strtol(p, &end, 10);
+        if (end == p) break;
+        long b = a;
+        p = end;
+        if (*p == '-') {
+            b = strtol(p + 1, &end, 10);
+            p = end;
+        }
+        for (long c = a; c <= b; c++) {
+            if (c != cpu) return (int)c;
+        }
+        if (*p != ',') break;
+        p++;
+    }
+    return -1;
+}
+
+static void* pack_helper(void* arg) {
+    PackPipeline* pp = (PackPipeline*)arg;
+
+    if (pp->helper_cpu >= 0) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(pp->helper_cpu, &set);
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    }
+
+    for (int p = 0; p < pp->num_panels; p++) {
+        int b = p % 2;
+        pthread_mutex_lock(&pp->lock);
+        while (pp->filled[b] != -1) pthread_cond_wait(&pp->cond, &pp->lock);
+        pthread_mutex_unlock(&pp->lock);
+
+        int pc, jc, kc, nc;
+        panel_coords(pp->n, p, &pc, &jc, &kc, &nc);
+        double t0 = get_time_sec();
+        pack_b_panel(pp->n, pp->B, pc, jc, kc, nc, pp->buf[b]);
+        pp->pack_time += get_time_sec() - t0;
+
+        pthread_mutex_lock(&pp->lock);
+        pp->filled[b] = p;
+        pthread_cond_broadcast(&pp->cond);
+        pthread_mutex_unlock(&pp->lock);
+    }
+    return NULL;
+}
+
+void dgemm_packed_pipeline(int n, double* A, double* B, double* C) {
+    PackPipeline pp;
+    pp.n = n;
+    pp.B = B;
+    pp.buf[0] = (double*)_mm_malloc((size_t)KC * (NC + NR) * sizeof(double), 64);
+    pp.buf[1] = (double*)_mm_malloc((size_t)KC * (NC + NR) * sizeof(double), 64);
+    if (!pp.buf[0] || !pp.buf[1]) {
+        printf("[ERRO] Falha ao alocar buffers do pipeline\n");
+        exit(1);
+    }
+    pp.filled[0] = pp.filled[1] = -1;
+    pp.num_panels = ((n + NC - 1) / NC) * ((n + KC - 1) / KC);
+    pp.pack_time = 0.0;
+    pthread_mutex_init(&pp.lock, NULL);
+    pthread_cond_init(&pp.cond, NULL);
+
+    // Pack no irmão SMT: o cálculo fica fixo na CPU atual durante a chamada
+    // e a thread de pack vai para a outra CPU lógica do mesmo núcleo, que
+    // compartilha L1/L2 com quem lê o painel. Sem irmão, sem afinidade.
+    cpu_set_t afinidade_antiga;
+    int fixou = 0;
+    pp.helper_cpu = PACK_HELPER_CPU;
+    if (PACK_HELPER_CPU == -1) {
+        int cpu = sched_getcpu();
+        int sib = (cpu >= 0) ? smt_sibling(cpu) : -1;
+        pp.helper_cpu = -1;
+        if (sib >= 0 && pthread_getaffinity_np(pthread_self(), sizeof(afinidade_antiga), &afinidade_antiga) == 0) {
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(cpu, &set);
+            if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0) {
+                fixou = 1;
+                pp.helper_cpu = sib;
+            }
+        }
+    }
+
+    PackStats st = {0};
+    double t_start = get_time_sec();
+
+    pthread_t helper;
+    if (pthread_create(&helper, NULL, pack_helper, &pp) != 0) {
+        printf("[ERRO] Falha ao criar thread de empacotamento\n");
+        exit(1);
+    }
+
+    for (int p = 0; p < pp.num_panels; p++) {
+        int b = p % 2;
+        double t0 = get_time_sec();
+        pthread_mutex_lock(&pp.lock);
+        while (pp.filled[b] != p) pthread_cond_wait(&pp.cond, &pp.lock);
+        pthread_mutex_unlock(&pp.lock);
+        st.wait_time += get_time_sec() - t0;
+
+        int pc, jc, kc, nc;
+        panel_coords(n, p, &pc, &jc, &kc, &nc);
+        compute_panel(n, A, pp.buf[b], C, pc, jc, kc, nc);
+
+        // Libera o buffer para o painel p+2
+        pthread_mutex_lock(&pp.lock);
+        pp.filled[b] = -1;
+        pthread_cond_broadcast(&pp.cond);
+        pthread_mutex_unlock(&pp.lock);
+    }
+
+    pthread_join(helper, NULL);
+    if (fixou) pthread_setaffinity_np(pthread_self(), sizeof(afinidade_antiga), &afinidade_antiga);
+    st.total_time = get_time_sec() - t_start;
+    st.pack_time = pp.pack_time;
+    st.panels = pp.num_panels;
+    last_stats = st;
+
+    pthread_mutex_destroy(&pp.lock);
+    pthread_cond_destroy(&pp.cond);
+    _mm_free(pp.buf[0]);
+    _mm_free(pp.buf[1]);
+}
+
+// --- VALIDAÇÃO ---
+double max_abs_diff(const double* X, const double* Y, int n) {
+    double diff = 0.0;
+    for (int i = 0; i < n * n; i++) {
+        double d = X[i] - Y[i];
+        if (d < 0) d = -d;
+        if (d > diff) diff = d;
+    }
+    return diff;
+}
+
+// --- BENCHMARK ---
+// Retorna o melhor tempo e guarda em *stats as métricas dessa execução
+double run_benchmark(void (*func)(int, double*, double*, double*), int n,
+                     double* A, double* B, double* C, PackStats* stats) {
+    for (int w = 0; w < WARMUP_RUNS; w++) {
+        clean_matrix(C, n);
+        func(n, A, B, C);
+    }
+
+    double best = 1e9;
+    for (int r = 0; r < NUM_RUNS; r++) {
+        clean_matrix(C, n);
+        double start = get_time_sec();
+        func(n, A, B, C);
+        double elapsed = get_time_sec() - start;
+        if (elapsed < best) {
+            best = elapsed;
+            if (stats) *stats = last_stats;
+        }
+    }
+    return best;
+}
+
+int main() {
+    int sizes[] = {256, 384, 512, 768, 1024};
+    int num_sizes = sizeof(sizes) / sizeof(sizes[0]);
+
+    printf("=== BENCHMARK DGEMM: EMPACOTAMENTO SERIAL vs PIPELINE ===\n");
+    printf("==========================================================\n");
+    printf("Painel B:        KC=%d x NC=%d (%zu KB, 2 buffers no pipeline)\n",
+           KC, NC, (size_t)KC * NC * sizeof(double) / 1024);
+    printf("Micro-kernel:    %dx%d\n", MR, NR);
+    if (PACK_HELPER_CPU >= 0) {
+        printf("Thread de pack:  fixada na CPU %d (PACK_HELPER_CPU)\n", PACK_HELPER_CPU);
+    } else {
+        int cpu = sched_getcpu();
+        int sib = (PACK_HELPER_CPU == -1 && cpu >= 0) ? smt_sibling(cpu) : -1;
+        if (sib >= 0) printf("Thread de pack:  irmão SMT (cálculo na CPU %d, pack na CPU %d)\n", cpu, sib);
+        else printf("Thread de pack:  sem afinidade (%s)\n", PACK_HELPER_CPU == -1 ? "CPU sem irmão SMT" : "livre");
+    }
+    printf("Núcleos lógicos: %ld\n", sysconf(_SC_NPROCESSORS_ONLN));
+    printf("\n");
+
+    printf("+--------+------------+------------+------------+------------+------------+----------+\n");
+    printf("| Tamanho| AVX+Block  | Pack serial| Pipeline   | Pack total | Exposto    | Escondido|\n");
+    printf("|        | (GFLOPS)   | (GFLOPS)   | (GFLOPS)   | (ms)       | (ms)       |          |\n");
+    printf("+--------+------------+------------+------------+------------+------------+----------+\n");
+
+    for (int s = 0; s < num_sizes; s++) {
+        int n = sizes[s];
+        double* A = alloc_matrix(n, "Matriz A");
+        double* B = alloc_matrix(n, "Matriz B");
+        double* C = alloc_matrix(n, "Matriz C");
+        double* C_ref = alloc_matrix(n, "Matriz C_ref");
+
+        clean_matrix(C_ref, n);
+        dgemm_avx_block(n, A, B, C_ref);
+        clean_matrix(C, n);
+        dgemm_packed_pipeline(n, A, B, C);
+        double err = max_abs_diff(C, C_ref, n);
+        if (err > 1e-9 * n) {
+            printf("[ERRO] Pipeline diverge da referência em %dx%d (erro %.2e)\n", n, n, err);
+        }
+
+        PackStats st_serial = {0}, st_pipe = {0};
+        double t_ref = run_benchmark(dgemm_avx_block, n, A, B, C, NULL);
+        double t_serial = run_benchmark(dgemm_packed_serial, n, A, B, C, &st_serial);
+        double t_pipe = run_benchmark(dgemm_packed_pipeline, n, A, B, C, &st_pipe);
+
+        double ops = 2.0 * (double)n * (double)n * (double)n;
+        double hidden = (st_pipe.pack_time > 0)
+                      ? (1.0 - st_pipe.wait_time / st_pipe.pack_time) * 100.0 : 0.0;
+        if (hidden < 0) hidden = 0;
+
+        printf("| %6d | %10.2f | %10.2f | %10.2f | %10.3f | %10.3f | %7.1f%% |\n",
+               n, ops / t_ref * 1e-9, ops / t_serial * 1e-9, ops / t_pipe * 1e-9,
+               st_pipe.pack_time * 1e3, st_pipe.wait_time * 1e3, hidden);
+
+        _mm_free(A);
+        _mm_free(B);
+        _mm_free(C);
+        _mm_free(C_ref);
+    }
+    printf("+--------+------------+------------+------------+------------+------------+----------+\n");
+    printf("\nPack total = tempo da thread auxiliar empacotando painéis de B\n");
+    printf("Exposto    = tempo em que o cálculo ficou parado esperando um painel\n");
+    printf("Escondido  = fração do empacotamento sobreposta ao cálculo\n");
+    printf("(com 1 núcleo lógico a thread auxiliar divide o núcleo com o cálculo:\n");
+    printf(" o empacotamento sai do caminho crítico visível, mas não fica de graça)\n");
+
+    return 0;
+}
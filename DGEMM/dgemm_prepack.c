@@ -0,0 +1,547 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <string.h>
+#include <immintrin.h>
+#include <stdint.h>
+#include <pthread.h>
+
+// --- CONFIGURAÇÕES ---
+#define BLOCK_SIZE 32               // Block size do kernel de referência
+#define KC 256                      // Linhas de B por painel empacotado
+#define NC 512                      // Colunas de B por painel empacotado
+#define MR 4                        // Linhas do micro-kernel
+#define NR 8                        // Colunas do micro-kernel (2 vetores AVX)
+#define PACK_CACHE_ENTRIES 4        // Máximo de B empacotados guardados
+#define PACK_CACHE_MB 256           // Limite de memória do cache (MB)
+#define NUM_RUNS 3                  // Execuções para média estatística
+#define WARMUP_RUNS 1               // Aquecimento de cache
+#define LRU_N 256                   // Tamanho das matrizes no teste do LRU
+#define LRU_CALLS 48                // Chamadas por cenário no teste do LRU
+
+// --- UTILITÁRIOS DE TEMPO (Alta Precisão) ---
+double get_time_sec() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// --- ALOCAÇÃO E INICIALIZAÇÃO ---
+double* alloc_matrix(int n, const char* name) {
+    double* ptr = (double*)_mm_malloc((size_t)n * n * sizeof(double), 64);
+    if (!ptr) {
+        printf("[ERRO] Falha ao alocar %s\n", name);
+        exit(1);
+    }
+
+    for (size_t i = 0; i < (size_t)n * n; i++) {
+        ptr[i] = (double)((i % 100) + 1) * 0.01;
+    }
+    return ptr;
+}
+
+void clean_matrix(double* C, int n) {
+    memset(C, 0, (size_t)n * n * sizeof(double));
+}
+
+static inline __m256d fma_pd(__m256d a, __m256d b, __m256d c) {
+    #ifdef __FMA__
+    return _mm256_fmadd_pd(a, b, c);
+    #else
+    return _mm256_add_pd(c, _mm256_mul_pd(a, b));
+    #endif
+}
+
+// --- REFERÊNCIA: AVX + BLOCKING (dgemm_aprimorado_2.c) ---
+// Relê B com passo de n doubles em toda chamada
+void dgemm_avx_block(int n, const double* A, const double* B, double* C) {
+    for (int i_blk = 0; i_blk < n; i_blk += BLOCK_SIZE) {
+        for (int k_blk = 0; k_blk < n; k_blk += BLOCK_SIZE) {
+            for (int j_blk = 0; j_blk < n; j_blk += BLOCK_SIZE) {
+
+                int i_max = (i_blk + BLOCK_SIZE > n) ? n : i_blk + BLOCK_SIZE;
+                int k_max = (k_blk + BLOCK_SIZE > n) ? n : k_blk + BLOCK_SIZE;
+                int j_max = (j_blk + BLOCK_SIZE > n) ? n : j_blk + BLOCK_SIZE;
+
+                for (int i = i_blk; i < i_max; i++) {
+                    for (int k = k_blk; k < k_max; k++) {
+                        __m256d a_vec = _mm256_set1_pd(A[(size_t)i * n + k]);
+                        int j = j_blk;
+                        for (; j <= j_max - 4; j += 4) {
+                            __m256d c_vec = _mm256_loadu_pd(&C[(size_t)i * n + j]);
+                            __m256d b_vec = _mm256_loadu_pd(&B[(size_t)k * n + j]);
+                            _mm256_storeu_pd(&C[(size_t)i * n + j], fma_pd(a_vec, b_vec, c_vec));
+                        }
+                        for (; j < j_max; j++) {
+                            C[(size_t)i * n + j] += A[(size_t)i * n + k] * B[(size_t)k * n + j];
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+// --- EMPACOTAMENTO DE B (mesmo layout de dgemm_pack_pipeline.c) ---
+// Painel kc x nc vira fatias de NR colunas contíguas: para cada fatia,
+// kc linhas de NR doubles (bordas completadas com zero).
+void pack_b_panel(int n, const double* B, int pc, int jc, int kc, int nc, double* Bp) {
+    for (int js = 0; js < nc; js += NR) {
+        int nr = (nc - js < NR) ? nc - js : NR;
+        for (int k = 0; k < kc; k++) {
+            const double* src = &B[(size_t)(pc + k) * n + jc + js];
+            if (nr == NR) {
+                _mm256_store_pd(&Bp[0], _mm256_loadu_pd(&src[0]));
+                _mm256_store_pd(&Bp[4], _mm256_loadu_pd(&src[4]));
+            } else {
+                for (int j = 0; j < NR; j++) Bp[j] = (j < nr) ? src[j] : 0.0;
+            }
+            Bp += NR;
+        }
+    }
+}
+
+// --- MICRO-KERNEL MR x NR SOBRE B EMPACOTADO ---
+void micro_kernel(int n, int kc, int mr, int nr, const double* A, const double* Bp, double* C) {
+    // Linhas além de mr repetem a linha 0 (resultado descartado)
+    const double* a0 = A;
+    const double* a1 = (mr > 1) ? A + n : A;
+    const double* a2 = (mr > 2) ? A + 2 * n : A;
+    const double* a3 = (mr > 3) ? A + 3 * n : A;
+
+    __m256d c00 = _mm256_setzero_pd(), c01 = _mm256_setzero_pd();
+    __m256d c10 = _mm256_setzero_pd(), c11 = _mm256_setzero_pd();
+    __m256d c20 = _mm256_setzero_pd(), c21 = _mm256_setzero_pd();
+    __m256d c30 = _mm256_setzero_pd(), c31 = _mm256_setzero_pd();
+
+    for (int k = 0; k < kc; k++) {
+        __m256d b0 = _mm256_load_pd(&Bp[k * NR]);
+        __m256d b1 = _mm256_load_pd(&Bp[k * NR + 4]);
+        __m256d a;
+        a = _mm256_broadcast_sd(&a0[k]); c00 = fma_pd(a, b0, c00); c01 = fma_pd(a, b1, c01);
+        a = _mm256_broadcast_sd(&a1[k]); c10 = fma_pd(a, b0, c10); c11 = fma_pd(a, b1, c11);
+        a = _mm256_broadcast_sd(&a2[k]); c20 = fma_pd(a, b0, c20); c21 = fma_pd(a, b1, c21);
+        a = _mm256_broadcast_sd(&a3[k]); c30 = fma_pd(a, b0, c30); c31 = fma_pd(a, b1, c31);
+    }
+
+    __m256d acc[MR][2] = {{c00, c01}, {c10, c11}, {c20, c21}, {c30, c31}};
+    if (mr == MR && nr == NR) {
+        for (int r = 0; r < MR; r++) {
+            double* c = &C[(size_t)r * n];
+            _mm256_storeu_pd(&c[0], _mm256_add_pd(_mm256_loadu_pd(&c[0]), acc[r][0]));
+            _mm256_storeu_pd(&c[4], _mm256_add_pd(_mm256_loadu_pd(&c[4]), acc[r][1]));
+        }
+    } else {
+        double tile[NR] __attribute__((aligned(32)));
+        for (int r = 0; r < mr; r++) {
+            _mm256_store_pd(&tile[0], acc[r][0]);
+            _mm256_store_pd(&tile[4], acc[r][1]);
+            for (int j = 0; j < nr; j++) C[(size_t)r * n + j] += tile[j];
+        }
+    }
+}
+
+// Calcula C[:, jc:jc+nc] += A[:, pc:pc+kc] * painel
+void compute_panel(int n, const double* A, const double* Bp, double* C,
+                   int pc, int jc, int kc, int nc) {
+    for (int i = 0; i < n; i += MR) {
+        int mr = (n - i < MR) ? n - i : MR;
+        for (int js = 0; js < nc; js += NR) {
+            int nr = (nc - js < NR) ? nc - js : NR;
+            micro_kernel(n, kc, mr, nr, &A[(size_t)i * n + pc], &Bp[(size_t)js * kc], &C[(size_t)i * n + jc + js]);
+        }
+    }
+}
+
+static void panel_coords(int n, int p, int* pc, int* jc, int* kc, int* nc) {
+    int k_panels = (n + KC - 1) / KC;
+    *jc = (p / k_panels) * NC;
+    *pc = (p % k_panels) * KC;
+    *nc = (n - *jc < NC) ? n - *jc : NC;
+    *kc = (n - *pc < KC) ? n - *pc : KC;
+}
+
+// --- B CRU: empacota painel a painel em toda chamada ---
+void dgemm_pack_each_call(int n, const double* A, const double* B, double* C) {
+    double* Bp = (double*)_mm_malloc((size_t)KC * (NC + NR) * sizeof(double), 64);
+    if (!Bp) {
+        printf("[ERRO] Falha ao alocar painel de B\n");
+        exit(1);
+    }
+    int num_panels = ((n + NC - 1) / NC) * ((n + KC - 1) / KC);
+    for (int p = 0; p < num_panels; p++) {
+        int pc, jc, kc, nc;
+        panel_coords(n, p, &pc, &jc, &kc, &nc);
+        pack_b_panel(n, B, pc, jc, kc, nc, Bp);
+        compute_panel(n, A, Bp, C, pc, jc, kc, nc);
+    }
+    _mm_free(Bp);
+}
+
+// ============================================================
+// --- B PRÉ-EMPACOTADO ---
+// ============================================================
+// dgemm_prepack_b empacota B inteiro uma vez, todos os painéis KC x NC já no
+// formato do micro-kernel, um atrás do outro na ordem em que o cálculo os usa.
+// dgemm_prepacked só lê o handle: nenhuma cópia nem leitura com passo n.
+// B original não é mais lido; se ele mudar, o handle fica velho (ver cache).
+typedef struct {
+    int n;
+    int num_panels;
+    size_t* offset;             // Início de cada painel em data
+    double* data;
+    size_t bytes;
+    // Chave e estado no cache
+    const double* src;
+    uint64_t version;
+    int refs;                   // Chamadas usando o handle agora
+    uint64_t last_use;          // Relógio do LRU
+} PackedB;
+
+PackedB* dgemm_prepack_b(int n, const double* B) {
+    PackedB* h = (PackedB*)calloc(1, sizeof(PackedB));
+    if (!h) {
+        printf("[ERRO] Falha ao alocar handle de B\n");
+        exit(1);
+    }
+    h->n = n;
+    h->num_panels = ((n + NC - 1) / NC) * ((n + KC - 1) / KC);
+    h->offset = (size_t*)malloc(h->num_panels * sizeof(size_t));
+    if (!h->offset) {
+        printf("[ERRO] Falha ao alocar offsets de B empacotado\n");
+        exit(1);
+    }
+
+    size_t total = 0;
+    for (int p = 0; p < h->num_panels; p++) {
+        int pc, jc, kc, nc;
+        panel_coords(n, p, &pc, &jc, &kc, &nc);
+        h->offset[p] = total;
+        total += (size_t)kc * ((nc + NR - 1) / NR) * NR;     // Borda completada até NR
+    }
+    h->bytes = total * sizeof(double);
+    h->data = (double*)_mm_malloc(h->bytes, 64);
+    if (!h->data) {
+        printf("[ERRO] Falha ao alocar B empacotado (%zu MB)\n", h->bytes >> 20);
+        exit(1);
+    }
+
+    for (int p = 0; p < h->num_panels; p++) {
+        int pc, jc, kc, nc;
+        panel_coords(n, p, &pc, &jc, &kc, &nc);
+        pack_b_panel(n, B, pc, jc, kc, nc, &h->data[h->offset[p]]);
+    }
+    return h;
+}
+
+void dgemm_packed_free(PackedB* h) {
+    if (!h) return;
+    _mm_free(h->data);
+    free(h->offset);
+    free(h);
+}
+
+// C += A * B, com B vindo do handle
+void dgemm_prepacked(int n, const double* A, const PackedB* Bp, double* C) {
+    if (Bp->n != n) {
+        printf("[ERRO] Handle de B empacotado para n=%d, chamada com n=%d\n", Bp->n, n);
+        exit(1);
+    }
+    for (int p = 0; p < Bp->num_panels; p++) {
+        int pc, jc, kc, nc;
+        panel_coords(n, p, &pc, &jc, &kc, &nc);
+        compute_panel(n, A, &Bp->data[Bp->offset[p]], C, pc, jc, kc, nc);
+    }
+}
+
+// ============================================================
+// --- CACHE LRU DE B EMPACOTADOS ---
+// ============================================================
+// Chave = (ponteiro, versão, n). Quem altera B no lugar incrementa a versão;
+// a versão antiga do mesmo ponteiro nunca mais acerta e sai na hora (se
+// ninguém estiver usando). Limites: PACK_CACHE_ENTRIES handles e
+// PACK_CACHE_MB de memória; na falta de espaço sai o menos usado
+// recentemente entre os que não estão em uso (refs == 0).
+// pack_cache_get devolve o handle com refs++; pack_cache_release devolve.
+typedef struct {
+    PackedB* entry[PACK_CACHE_ENTRIES];
+    size_t max_bytes, bytes_used;
+    uint64_t clock;
+    uint64_t hits, misses, evictions;
+    pthread_mutex_t lock;
+} PackCache;
+
+void pack_cache_init(PackCache* pc, size_t max_bytes) {
+    memset(pc, 0, sizeof(*pc));
+    pc->max_bytes = max_bytes;
+    pthread_mutex_init(&pc->lock, NULL);
+}
+
+static void pack_cache_remove(PackCache* pc, int e) {
+    pc->bytes_used -= pc->entry[e]->bytes;
+    dgemm_packed_free(pc->entry[e]);
+    pc->entry[e] = NULL;
+}
+
+// Entrada ocupada menos usada recentemente e sem uso; -1 se não houver
+static int pack_cache_lru(const PackCache* pc) {
+    int lru = -1;
+    for (int e = 0; e < PACK_CACHE_ENTRIES; e++) {
+        const PackedB* h = pc->entry[e];
+        if (h && h->refs == 0 && (lru < 0 || h->last_use < pc->entry[lru]->last_use)) lru = e;
+    }
+    return lru;
+}
+
+// Entrada com a chave (B, versão, n), com refs++; NULL se não houver
+static PackedB* pack_cache_lookup(PackCache* pc, int n, const double* B, uint64_t version) {
+    for (int e = 0; e < PACK_CACHE_ENTRIES; e++) {
+        PackedB* h = pc->entry[e];
+        if (h && h->src == B && h->version == version && h->n == n) {
+            h->refs++;
+            h->last_use = pc->clock;
+            return h;
+        }
+    }
+    return NULL;
+}
+
+PackedB* pack_cache_get(PackCache* pc, int n, const double* B, uint64_t version) {
+    pthread_mutex_lock(&pc->lock);
+    pc->clock++;
+    PackedB* hit = pack_cache_lookup(pc, n, B, version);
+    if (hit) pc->hits++;
+    else pc->misses++;
+    pthread_mutex_unlock(&pc->lock);
+    if (hit) return hit;
+
+    // Empacota fora do lock: os outros acertos não esperam a cópia de B
+    PackedB* h = dgemm_prepack_b(n, B);
+    h->src = B;
+    h->version = version;
+    h->refs = 1;
+
+    pthread_mutex_lock(&pc->lock);
+    pc->clock++;
+    h->last_use = pc->clock;
+
+    // Outra thread empacotou a mesma chave enquanto isso: usa a dela (o
+    // empacotamento já contou como falta) e descarta a cópia
+    hit = pack_cache_lookup(pc, n, B, version);
+    if (hit) {
+        pthread_mutex_unlock(&pc->lock);
+        dgemm_packed_free(h);
+        return hit;
+    }
+
+    // Versões antigas do mesmo B não voltam mais
+    for (int e = 0; e < PACK_CACHE_ENTRIES; e++) {
+        PackedB* old = pc->entry[e];
+        if (old && old->src == B && old->refs == 0) {
+            pack_cache_remove(pc, e);
+            pc->evictions++;
+        }
+    }
+
+    // Abre espaço (entradas e bytes) tirando as LRU sem uso
+    int slot = -1;
+    while (1) {
+        int free_slot = -1;
+        for (int e = 0; e < PACK_CACHE_ENTRIES && free_slot < 0; e++) {
+            if (!pc->entry[e]) free_slot = e;
+        }
+        if (free_slot >= 0 && pc->bytes_used + h->bytes <= pc->max_bytes) {
+            slot = free_slot;
+            break;
+        }
+        int lru = pack_cache_lru(pc);
+        if (lru < 0) break;
+        pack_cache_remove(pc, lru);
+        pc->evictions++;
+    }
+
+    if (slot >= 0) {
+        pc->entry[slot] = h;
+        pc->bytes_used += h->bytes;
+    }
+    // Sem espaço (tudo em uso ou B maior que o limite): o handle fica fora do
+    // cache e é liberado no release (refs chega a 0 e src == NULL)
+    else h->src = NULL;
+    pthread_mutex_unlock(&pc->lock);
+    return h;
+}
+
+void pack_cache_release(PackCache* pc, PackedB* h) {
+    pthread_mutex_lock(&pc->lock);
+    h->refs--;
+    int orphan = (h->src == NULL && h->refs == 0);
+    pthread_mutex_unlock(&pc->lock);
+    if (orphan) dgemm_packed_free(h);
+}
+
+void pack_cache_destroy(PackCache* pc) {
+    for (int e = 0; e < PACK_CACHE_ENTRIES; e++) {
+        if (pc->entry[e]) pack_cache_remove(pc, e);
+    }
+    pthread_mutex_destroy(&pc->lock);
+}
+
+// Chamada de serviço: C += A * B com B tirado do cache (empacota só na falta)
+void dgemm_cached(PackCache* pc, int n, const double* A, const double* B, uint64_t version, double* C) {
+    PackedB* h = pack_cache_get(pc, n, B, version);
+    dgemm_prepacked(n, A, h, C);
+    pack_cache_release(pc, h);
+}
+
+// --- VALIDAÇÃO ---
+double max_abs_diff(const double* X, const double* Y, int n) {
+    double diff = 0.0;
+    for (size_t i = 0; i < (size_t)n * n; i++) {
+        double d = X[i] - Y[i];
+        if (d < 0) d = -d;
+        if (d > diff) diff = d;
+    }
+    return diff;
+}
+
+// --- BENCHMARK ---
+static PackCache bench_cache;
+static const PackedB* bench_handle;
+
+static void run_avx_block(int n, double* A, double* B, double* C) { dgemm_avx_block(n, A, B, C); }
+static void run_pack_each(int n, double* A, double* B, double* C) { dgemm_pack_each_call(n, A, B, C); }
+static void run_prepacked(int n, double* A, double* B, double* C) { (void)B; dgemm_prepacked(n, A, bench_handle, C); }
+static void run_cached(int n, double* A, double* B, double* C) { dgemm_cached(&bench_cache, n, A, B, 1, C); }
+
+// Melhor tempo por chamada (A nova a cada chamada no serviço: aqui A fica
+// igual, só B importa para o que está sendo medido)
+double run_benchmark(void (*func)(int, double*, double*, double*), int n,
+                     double* A, double* B, double* C) {
+    for (int w = 0; w < WARMUP_RUNS; w++) {
+        clean_matrix(C, n);
+        func(n, A, B, C);
+    }
+
+    double best = 1e9;
+    for (int r = 0; r < NUM_RUNS; r++) {
+        clean_matrix(C, n);
+        double start = get_time_sec();
+        func(n, A, B, C);
+        double elapsed = get_time_sec() - start;
+        if (elapsed < best) best = elapsed;
+    }
+    return best;
+}
+
+// Serviço com W matrizes de pesos usadas em rodízio: com W > PACK_CACHE_ENTRIES
+// o LRU erra sempre (cada B sai um pouco antes de voltar)
+static void lru_scenario(int weights, double* A, double* C) {
+    int n = LRU_N;
+    double** W = (double**)malloc(weights * sizeof(double*));
+    for (int w = 0; w < weights; w++) W[w] = alloc_matrix(n, "Pesos");
+
+    PackCache pc;
+    pack_cache_init(&pc, (size_t)PACK_CACHE_MB << 20);
+    double start = get_time_sec();
+    for (int c = 0; c < LRU_CALLS; c++) {
+        // Na metade das chamadas os pesos 0 são atualizados (nova versão)
+        uint64_t version = (c >= LRU_CALLS / 2) ? 2 : 1;
+        int w = c % weights;
+        if (w == 0 && c == LRU_CALLS / 2) W[0][0] += 1.0;
+        clean_matrix(C, n);
+        dgemm_cached(&pc, n, A, W[w], (w == 0) ? version : 1, C);
+    }
+    double per_call = (get_time_sec() - start) / LRU_CALLS;
+
+    printf("| %7d | %8d | %6llu | %6llu | %9llu | %10.1f | %11.3f |\n",
+           weights, PACK_CACHE_ENTRIES, (unsigned long long)pc.hits, (unsigned long long)pc.misses,
+           (unsigned long long)pc.evictions, (double)pc.bytes_used / (1 << 20), per_call * 1e3);
+
+    pack_cache_destroy(&pc);
+    for (int w = 0; w < weights; w++) _mm_free(W[w]);
+    free(W);
+}
+
+int main() {
+    int sizes[] = {256, 512, 1024, 1536, 2048};
+    int num_sizes = sizeof(sizes) / sizeof(sizes[0]);
+
+    printf("=== BENCHMARK DGEMM: B PRÉ-EMPACOTADO x B CRU ===\n");
+    printf("==========================================================\n");
+    printf("Painel B:        KC=%d x NC=%d, micro-kernel %dx%d\n", KC, NC, MR, NR);
+    printf("Cache de B:      %d entradas, %d MB, LRU por (ponteiro, versão)\n", PACK_CACHE_ENTRIES, PACK_CACHE_MB);
+    printf("Tempo por chamada: melhor de %d (mesmo B em todas as chamadas)\n\n", NUM_RUNS);
+
+    printf("+--------+------------+------------+------------+------------+------------+----------+----------+\n");
+    printf("| Tamanho| AVX+Block  | Pack cada  | Pré-empac. | Via cache  | Pack único | Speedup  | Empate   |\n");
+    printf("|        | (ms)       | (ms)       | (ms)       | (ms)       | (ms)       | vs Block | chamadas |\n");
+    printf("+--------+------------+------------+------------+------------+------------+----------+----------+\n");
+
+    for (int s = 0; s < num_sizes; s++) {
+        int n = sizes[s];
+        double* A = alloc_matrix(n, "Matriz A");
+        double* B = alloc_matrix(n, "Matriz B");
+        double* C = alloc_matrix(n, "Matriz C");
+        double* C_ref = alloc_matrix(n, "Matriz C_ref");
+
+        double t0 = get_time_sec();
+        PackedB* h = dgemm_prepack_b(n, B);
+        double t_pack = get_time_sec() - t0;
+        bench_handle = h;
+        pack_cache_init(&bench_cache, (size_t)PACK_CACHE_MB << 20);
+
+        clean_matrix(C_ref, n);
+        dgemm_avx_block(n, A, B, C_ref);
+        clean_matrix(C, n);
+        dgemm_cached(&bench_cache, n, A, B, 1, C);
+        double err = max_abs_diff(C, C_ref, n);
+        if (err > 1e-9 * n) {
+            printf("[ERRO] B pré-empacotado diverge da referência em %dx%d (erro %.2e)\n", n, n, err);
+        }
+
+        double t_ref = run_benchmark(run_avx_block, n, A, B, C);
+        double t_each = run_benchmark(run_pack_each, n, A, B, C);
+        double t_pre = run_benchmark(run_prepacked, n, A, B, C);
+        double t_cached = run_benchmark(run_cached, n, A, B, C);
+
+        // Chamadas até o pacote único se pagar contra empacotar toda vez
+        double gain = t_each - t_pre;
+        char breakeven[16];
+        if (gain > 0) snprintf(breakeven, sizeof(breakeven), "%8.1f", t_pack / gain);
+        else snprintf(breakeven, sizeof(breakeven), "%8s", "-");
+
+        printf("| %6d | %10.3f | %10.3f | %10.3f | %10.3f | %10.3f | %7.2fx | %s |\n",
+               n, t_ref * 1e3, t_each * 1e3, t_pre * 1e3, t_cached * 1e3, t_pack * 1e3,
+               t_ref / t_cached, breakeven);
+
+        pack_cache_destroy(&bench_cache);
+        dgemm_packed_free(h);
+        _mm_free(A);
+        _mm_free(B);
+        _mm_free(C);
+        _mm_free(C_ref);
+    }
+    printf("+--------+------------+------------+------------+------------+------------+----------+----------+\n");
+    printf("\nAVX+Block    = dgemm_avx_block, lê B cru com passo n\n");
+    printf("Pack cada    = empacota cada painel de B em toda chamada (sem handle)\n");
+    printf("Pré-empac.   = dgemm_prepacked com o handle pronto\n");
+    printf("Via cache    = dgemm_cached: busca no LRU (acerto) + dgemm_prepacked\n");
+    printf("Empate       = chamadas até o pack único compensar contra Pack cada\n");
+
+    // --- Comportamento do LRU ---
+    printf("\n=== CACHE LRU: MATRIZES DE PESOS EM RODÍZIO (n=%d, %d chamadas) ===\n", LRU_N, LRU_CALLS);
+    printf("+---------+----------+--------+--------+-----------+------------+-------------+\n");
+    printf("| Pesos   | Entradas | Acertos| Faltas | Remoções  | Memória MB | ms/chamada  |\n");
+    printf("+---------+----------+--------+--------+-----------+------------+-------------+\n");
+    double* A = alloc_matrix(LRU_N, "Matriz A");
+    double* C = alloc_matrix(LRU_N, "Matriz C");
+    int scenarios[] = {1, PACK_CACHE_ENTRIES, PACK_CACHE_ENTRIES + 2};
+    for (int s = 0; s < 3; s++) lru_scenario(scenarios[s], A, C);
+    printf("+---------+----------+--------+--------+-----------+------------+-------------+\n");
+    printf("Na metade das chamadas os pesos 0 mudam de versão: 1 falta extra e a versão velha sai.\n");
+    printf("Com mais pesos que entradas o rodízio derruba o LRU (toda chamada empacota de novo).\n");
+    _mm_free(A);
+    _mm_free(C);
+
+    return 0;
+}
@@ -0,0 +1,562 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <string.h>
+#include <math.h>
+#include <immintrin.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <pthread.h>
+
+// --- CONFIGURAÇÕES ---
+#define BLOCK_SIZE 32           // Faixas de linhas do denso entre threads
+#define KC 256                  // Linhas de B por painel empacotado (denso)
+#define NC 512                  // Colunas de B por painel empacotado (denso)
+#define MR 4                    // Linhas do micro-kernel denso
+#define NR 8                    // Colunas do micro-kernel denso (2 vetores AVX)
+#define BR 4                    // Linhas por bloco BCSR
+#define BC 4                    // Colunas por bloco BCSR
+#define MAX_THREADS 64          // Limite de threads
+#define NUM_RUNS 3              // Execuções para média estatística
+#define SEED 2024               // Semente dos padrões esparsos
+
+// --- UTILITÁRIOS DE TEMPO (Alta Precisão) ---
+double get_time_sec() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// --- ALOCAÇÃO E INICIALIZAÇÃO (retangular) ---
+double* alloc_rect(int rows, int cols, const char* name) {
+    double* ptr = (double*)_mm_malloc((size_t)rows * cols * sizeof(double), 64);
+    if (!ptr) {
+        printf("[ERRO] Falha ao alocar %s\n", name);
+        exit(1);
+    }
+
+    for (size_t i = 0; i < (size_t)rows * cols; i++) {
+        ptr[i] = (double)((i % 100) + 1) * 0.01;
+    }
+    return ptr;
+}
+
+static void* xmalloc(size_t bytes, const char* name) {
+    void* p = _mm_malloc(bytes ? bytes : 64, 64);
+    if (!p) {
+        printf("[ERRO] Falha ao alocar %s\n", name);
+        exit(1);
+    }
+    return p;
+}
+
+static inline __m256d fma_pd(__m256d a, __m256d b, __m256d c) {
+    #ifdef __FMA__
+    return _mm256_fmadd_pd(a, b, c);
+    #else
+    return _mm256_add_pd(c, _mm256_mul_pd(a, b));
+    #endif
+}
+
+// ============================================================
+// --- FORMATOS ESPARSOS ---
+// ============================================================
+// CSR:  row_ptr[m+1], col_idx[nnz], val[nnz]
+// BCSR: blocos densos BR x BC; por linha de blocos, os blocos não nulos
+//       (qualquer elemento != 0) em ordem de coluna. val guarda cada bloco
+//       em linha (BR*BC valores), então um bloco vira BR*BC broadcasts que
+//       reutilizam as BC linhas de B carregadas.
+typedef struct {
+    int m, k, nnz;
+    int* row_ptr;
+    int* col_idx;
+    double* val;
+} CSR;
+
+typedef struct {
+    int m, k, mb, kb, nblocks;
+    int* brow_ptr;
+    int* bcol_idx;
+    double* val;            // nblocks * BR * BC
+    long nnz;               // Não zeros reais (para GFLOPS úteis)
+} BCSR;
+
+CSR dense_to_csr(const double* A, int m, int k) {
+    CSR s = {m, k, 0, NULL, NULL, NULL};
+    for (size_t i = 0; i < (size_t)m * k; i++) s.nnz += (A[i] != 0.0);
+    s.row_ptr = (int*)xmalloc((m + 1) * sizeof(int), "CSR row_ptr");
+    s.col_idx = (int*)xmalloc(s.nnz * sizeof(int), "CSR col_idx");
+    s.val = (double*)xmalloc(s.nnz * sizeof(double), "CSR val");
+
+    int p = 0;
+    for (int i = 0; i < m; i++) {
+        s.row_ptr[i] = p;
+        for (int j = 0; j < k; j++) {
+            double v = A[(size_t)i * k + j];
+            if (v != 0.0) {
+                s.col_idx[p] = j;
+                s.val[p] = v;
+                p++;
+            }
+        }
+    }
+    s.row_ptr[m] = p;
+    return s;
+}
+
+// m e k múltiplos de BR e BC (o benchmark usa potências de 2)
+BCSR dense_to_bcsr(const double* A, int m, int k) {
+    BCSR s = {m, k, m / BR, k / BC, 0, NULL, NULL, NULL, 0};
+    s.brow_ptr = (int*)xmalloc((s.mb + 1) * sizeof(int), "BCSR brow_ptr");
+
+    // Primeira passada: conta blocos não nulos
+    for (int bi = 0; bi < s.mb; bi++) {
+        for (int bj = 0; bj < s.kb; bj++) {
+            int nz = 0;
+            for (int r = 0; r < BR; r++)
+                for (int c = 0; c < BC; c++) nz |= (A[(size_t)(bi * BR + r) * k + bj * BC + c] != 0.0);
+            s.nblocks += nz;
+        }
+    }
+    s.bcol_idx = (int*)xmalloc(s.nblocks * sizeof(int), "BCSR bcol_idx");
+    s.val = (double*)xmalloc((size_t)s.nblocks * BR * BC * sizeof(double), "BCSR val");
+
+    int p = 0;
+    for (int bi = 0; bi < s.mb; bi++) {
+        s.brow_ptr[bi] = p;
+        for (int bj = 0; bj < s.kb; bj++) {
+            int nz = 0;
+            for (int r = 0; r < BR; r++)
+                for (int c = 0; c < BC; c++) nz |= (A[(size_t)(bi * BR + r) * k + bj * BC + c] != 0.0);
+            if (!nz) continue;
+            s.bcol_idx[p] = bj;
+            for (int r = 0; r < BR; r++) {
+                for (int c = 0; c < BC; c++) {
+                    double v = A[(size_t)(bi * BR + r) * k + bj * BC + c];
+                    s.val[(size_t)p * BR * BC + r * BC + c] = v;
+                    s.nnz += (v != 0.0);
+                }
+            }
+            p++;
+        }
+    }
+    s.brow_ptr[s.mb] = p;
+    return s;
+}
+
+void free_csr(CSR* s) { _mm_free(s->row_ptr); _mm_free(s->col_idx); _mm_free(s->val); }
+void free_bcsr(BCSR* s) { _mm_free(s->brow_ptr); _mm_free(s->bcol_idx); _mm_free(s->val); }
+
+// ============================================================
+// --- KERNELS SpMM: C[m x n] = A_esparsa[m x k] * B[k x n] ---
+// ============================================================
+// Vetorizados sobre as colunas de B: para cada linha de A, 32 colunas de C
+// ficam em 8 registradores enquanto os não zeros da linha são percorridos;
+// cada não zero é um broadcast + 8 FMAs sobre a linha correspondente de B.
+void spmm_csr_rows(const CSR* A, const double* B, double* C, int n, int row_begin, int row_end) {
+    for (int i = row_begin; i < row_end; i++) {
+        int p0 = A->row_ptr[i], p1 = A->row_ptr[i + 1];
+        double* c_row = &C[(size_t)i * n];
+        int j = 0;
+        for (; j <= n - 32; j += 32) {
+            __m256d c0 = _mm256_setzero_pd(), c1 = c0, c2 = c0, c3 = c0;
+            __m256d c4 = c0, c5 = c0, c6 = c0, c7 = c0;
+            for (int p = p0; p < p1; p++) {
+                __m256d a = _mm256_set1_pd(A->val[p]);
+                const double* b = &B[(size_t)A->col_idx[p] * n + j];
+                c0 = fma_pd(a, _mm256_loadu_pd(b), c0);
+                c1 = fma_pd(a, _mm256_loadu_pd(b + 4), c1);
+                c2 = fma_pd(a, _mm256_loadu_pd(b + 8), c2);
+                c3 = fma_pd(a, _mm256_loadu_pd(b + 12), c3);
+                c4 = fma_pd(a, _mm256_loadu_pd(b + 16), c4);
+                c5 = fma_pd(a, _mm256_loadu_pd(b + 20), c5);
+                c6 = fma_pd(a, _mm256_loadu_pd(b + 24), c6);
+                c7 = fma_pd(a, _mm256_loadu_pd(b + 28), c7);
+            }
+            _mm256_storeu_pd(&c_row[j], c0);
+            _mm256_storeu_pd(&c_row[j + 4], c1);
+            _mm256_storeu_pd(&c_row[j + 8], c2);
+            _mm256_storeu_pd(&c_row[j + 12], c3);
+            _mm256_storeu_pd(&c_row[j + 16], c4);
+            _mm256_storeu_pd(&c_row[j + 20], c5);
+            _mm256_storeu_pd(&c_row[j + 24], c6);
+            _mm256_storeu_pd(&c_row[j + 28], c7);
+        }
+        for (; j <= n - 4; j += 4) {
+            __m256d c0 = _mm256_setzero_pd();
+            for (int p = p0; p < p1; p++) {
+                c0 = fma_pd(_mm256_set1_pd(A->val[p]), _mm256_loadu_pd(&B[(size_t)A->col_idx[p] * n + j]), c0);
+            }
+            _mm256_storeu_pd(&c_row[j], c0);
+        }
+        for (; j < n; j++) {
+            double sum = 0.0;
+            for (int p = p0; p < p1; p++) sum += A->val[p] * B[(size_t)A->col_idx[p] * n + j];
+            c_row[j] = sum;
+        }
+    }
+}
+
+// BCSR BR x BC: BR linhas de C x 8 colunas em 8 registradores; cada bloco
+// carrega BC linhas de B (2 vetores cada) e as usa nas BR linhas
+void spmm_bcsr_rows(const BCSR* A, const double* B, double* C, int n, int brow_begin, int brow_end) {
+    for (int bi = brow_begin; bi < brow_end; bi++) {
+        int p0 = A->brow_ptr[bi], p1 = A->brow_ptr[bi + 1];
+        double* c_base = &C[(size_t)bi * BR * n];
+        int j = 0;
+        for (; j <= n - 8; j += 8) {
+            __m256d acc[BR][2];
+            for (int r = 0; r < BR; r++) acc[r][0] = acc[r][1] = _mm256_setzero_pd();
+
+            for (int p = p0; p < p1; p++) {
+                const double* v = &A->val[(size_t)p * BR * BC];
+                const double* b = &B[(size_t)A->bcol_idx[p] * BC * n + j];
+                for (int c = 0; c < BC; c++) {
+                    __m256d b0 = _mm256_loadu_pd(&b[(size_t)c * n]);
+                    __m256d b1 = _mm256_loadu_pd(&b[(size_t)c * n + 4]);
+                    for (int r = 0; r < BR; r++) {
+                        __m256d a = _mm256_set1_pd(v[r * BC + c]);
+                        acc[r][0] = fma_pd(a, b0, acc[r][0]);
+                        acc[r][1] = fma_pd(a, b1, acc[r][1]);
+                    }
+                }
+            }
+            for (int r = 0; r < BR; r++) {
+                _mm256_storeu_pd(&c_base[(size_t)r * n + j], acc[r][0]);
+                _mm256_storeu_pd(&c_base[(size_t)r * n + j + 4], acc[r][1]);
+            }
+        }
+        for (; j < n; j++) {
+            for (int r = 0; r < BR; r++) {
+                double sum = 0.0;
+                for (int p = p0; p < p1; p++) {
+                    for (int c = 0; c < BC; c++) {
+                        sum += A->val[(size_t)p * BR * BC + r * BC + c] * B[(size_t)(A->bcol_idx[p] * BC + c) * n + j];
+                    }
+                }
+                c_base[(size_t)r * n + j] = sum;
+            }
+        }
+    }
+}
+
+// ============================================================
+// --- DENSO DE REFERÊNCIA: B EMPACOTADO + MICRO-KERNEL MR x NR ---
+// ============================================================
+// Mesmo kernel de dgemm_pack_pipeline.c, com A (m x k) e B/C (n colunas)
+// retangulares. B é empacotado inteiro uma vez por chamada: painéis KC x NC,
+// cada um em fatias de NR colunas contíguas (borda completada com zero).
+// O painel (jc, pc) começa em jc * k + pc * nc_pad (NC é múltiplo de NR).
+static inline int pad_nr(int nc) { return (nc + NR - 1) / NR * NR; }
+
+void pack_b_full(int k, int n, const double* B, double* Bp) {
+    for (int jc = 0; jc < n; jc += NC) {
+        int nc = (n - jc < NC) ? n - jc : NC;
+        for (int pc = 0; pc < k; pc += KC) {
+            int kc = (k - pc < KC) ? k - pc : KC;
+            double* dst = &Bp[(size_t)jc * k + (size_t)pc * pad_nr(nc)];
+            for (int js = 0; js < nc; js += NR) {
+                int nr = (nc - js < NR) ? nc - js : NR;
+                for (int kk = 0; kk < kc; kk++) {
+                    const double* src = &B[(size_t)(pc + kk) * n + jc + js];
+                    if (nr == NR) {
+                        _mm256_store_pd(&dst[0], _mm256_loadu_pd(&src[0]));
+                        _mm256_store_pd(&dst[4], _mm256_loadu_pd(&src[4]));
+                    } else {
+                        for (int j = 0; j < NR; j++) dst[j] = (j < nr) ? src[j] : 0.0;
+                    }
+                    dst += NR;
+                }
+            }
+        }
+    }
+}
+
+static void micro_kernel(int lda, int ldc, int kc, int mr, int nr,
+                         const double* A, const double* Bp, double* C) {
+    // Linhas além de mr repetem a linha 0 (resultado descartado)
+    const double* a0 = A;
+    const double* a1 = (mr > 1) ? A + lda : A;
+    const double* a2 = (mr > 2) ? A + 2 * (size_t)lda : A;
+    const double* a3 = (mr > 3) ? A + 3 * (size_t)lda : A;
+
+    __m256d c00 = _mm256_setzero_pd(), c01 = _mm256_setzero_pd();
+    __m256d c10 = _mm256_setzero_pd(), c11 = _mm256_setzero_pd();
+    __m256d c20 = _mm256_setzero_pd(), c21 = _mm256_setzero_pd();
+    __m256d c30 = _mm256_setzero_pd(), c31 = _mm256_setzero_pd();
+
+    for (int kk = 0; kk < kc; kk++) {
+        __m256d b0 = _mm256_load_pd(&Bp[kk * NR]);
+        __m256d b1 = _mm256_load_pd(&Bp[kk * NR + 4]);
+        __m256d a;
+        a = _mm256_broadcast_sd(&a0[kk]); c00 = fma_pd(a, b0, c00); c01 = fma_pd(a, b1, c01);
+        a = _mm256_broadcast_sd(&a1[kk]); c10 = fma_pd(a, b0, c10); c11 = fma_pd(a, b1, c11);
+        a = _mm256_broadcast_sd(&a2[kk]); c20 = fma_pd(a, b0, c20); c21 = fma_pd(a, b1, c21);
+        a = _mm256_broadcast_sd(&a3[kk]); c30 = fma_pd(a, b0, c30); c31 = fma_pd(a, b1, c31);
+    }
+
+    __m256d acc[MR][2] = {{c00, c01}, {c10, c11}, {c20, c21}, {c30, c31}};
+    if (mr == MR && nr == NR) {
+        for (int r = 0; r < MR; r++) {
+            double* c = &C[(size_t)r * ldc];
+            _mm256_storeu_pd(&c[0], _mm256_add_pd(_mm256_loadu_pd(&c[0]), acc[r][0]));
+            _mm256_storeu_pd(&c[4], _mm256_add_pd(_mm256_loadu_pd(&c[4]), acc[r][1]));
+        }
+    } else {
+        double tile[NR] __attribute__((aligned(32)));
+        for (int r = 0; r < mr; r++) {
+            _mm256_store_pd(&tile[0], acc[r][0]);
+            _mm256_store_pd(&tile[4], acc[r][1]);
+            for (int j = 0; j < nr; j++) C[(size_t)r * ldc + j] += tile[j];
+        }
+    }
+}
+
+// C[row_begin:row_end, :] += A[linhas, :] * B, com B já empacotado por pack_b_full
+void dgemm_packed_rows(int k, int n, const double* A, const double* Bp, double* C,
+                       int row_begin, int row_end) {
+    for (int jc = 0; jc < n; jc += NC) {
+        int nc = (n - jc < NC) ? n - jc : NC;
+        for (int pc = 0; pc < k; pc += KC) {
+            int kc = (k - pc < KC) ? k - pc : KC;
+            const double* panel = &Bp[(size_t)jc * k + (size_t)pc * pad_nr(nc)];
+            for (int i = row_begin; i < row_end; i += MR) {
+                int mr = (row_end - i < MR) ? row_end - i : MR;
+                for (int js = 0; js < nc; js += NR) {
+                    int nr = (nc - js < NR) ? nc - js : NR;
+                    micro_kernel(k, n, kc, mr, nr, &A[(size_t)i * k + pc], &panel[(size_t)js * kc],
+                                 &C[(size_t)i * n + jc + js]);
+                }
+            }
+        }
+    }
+}
+
+// ============================================================
+// --- PARALELISMO POR LINHAS ---
+// ============================================================
+// As faixas de linhas são cortadas pelo número de não zeros (prefixo de
+// row_ptr), não pelo número de linhas, para equilibrar padrões irregulares.
+typedef enum { KER_DENSO, KER_CSR, KER_BCSR } Kernel;
+
+typedef struct {
+    Kernel ker;
+    const void* A;
+    const double* B;
+    double* C;
+    int m, k, n;
+    int begin, end;     // Linhas (denso/CSR) ou linhas de blocos (BCSR)
+    const double* Bp;   // Denso: B empacotado
+} SpmmTask;
+
+static void* spmm_worker(void* p) {
+    SpmmTask* t = (SpmmTask*)p;
+    if (t->ker == KER_CSR) {
+        spmm_csr_rows((const CSR*)t->A, t->B, t->C, t->n, t->begin, t->end);
+    } else if (t->ker == KER_BCSR) {
+        spmm_bcsr_rows((const BCSR*)t->A, t->B, t->C, t->n, t->begin, t->end);
+    } else {
+        dgemm_packed_rows(t->k, t->n, (const double*)t->A, t->Bp, t->C, t->begin, t->end);
+    }
+    return NULL;
+}
+
+// Divide [0, count) em nthreads faixas com peso aproximadamente igual (ptr = prefixo do peso)
+static void split_by_weight(const int* ptr, int count, int nthreads, int* cuts) {
+    long total = ptr[count];
+    int pos = 0;
+    cuts[0] = 0;
+    for (int t = 1; t < nthreads; t++) {
+        long alvo = total * t / nthreads;
+        while (pos < count && ptr[pos] < alvo) pos++;
+        cuts[t] = pos;
+    }
+    cuts[nthreads] = count;
+}
+
+// Buffer do B empacotado do denso, reaproveitado entre chamadas
+static double* dense_bp = NULL;
+static size_t dense_bp_size = 0;
+
+void run_parallel(Kernel ker, const void* A, const double* B, double* C, int m, int k, int n, int nthreads) {
+    pthread_t threads[MAX_THREADS];
+    SpmmTask tasks[MAX_THREADS];
+    int cuts[MAX_THREADS + 1];
+    int started[MAX_THREADS] = {0};
+    const double* Bp = NULL;
+
+    if (ker == KER_CSR) {
+        const CSR* s = (const CSR*)A;
+        split_by_weight(s->row_ptr, s->m, nthreads, cuts);
+    } else if (ker == KER_BCSR) {
+        const BCSR* s = (const BCSR*)A;
+        split_by_weight(s->brow_ptr, s->mb, nthreads, cuts);
+    } else {
+        // Denso: empacota B (entra no tempo) e divide em faixas de BLOCK_SIZE linhas
+        size_t need = (size_t)k * pad_nr(n) * sizeof(double);
+        if (need > dense_bp_size) {
+            _mm_free(dense_bp);
+            dense_bp = (double*)xmalloc(need, "B empacotado");
+            dense_bp_size = need;
+        }
+        pack_b_full(k, n, B, dense_bp);
+        Bp = dense_bp;
+        int nblk = (m + BLOCK_SIZE - 1) / BLOCK_SIZE;
+        for (int t = 0; t <= nthreads; t++) {
+            int c = (int)((long)nblk * t / nthreads) * BLOCK_SIZE;
+            cuts[t] = c > m ? m : c;
+        }
+        memset(C, 0, (size_t)m * n * sizeof(double));
+    }
+
+    for (int t = 0; t < nthreads; t++) {
+        tasks[t] = (SpmmTask){ker, A, B, C, m, k, n, cuts[t], cuts[t + 1], Bp};
+        if (t > 0) {
+            // Sem thread, a faixa roda aqui mesmo: nenhuma linha de C fica sem cálculo
+            if (pthread_create(&threads[t], NULL, spmm_worker, &tasks[t]) == 0) started[t] = 1;
+            else spmm_worker(&tasks[t]);
+        }
+    }
+    spmm_worker(&tasks[0]);
+    for (int t = 1; t < nthreads; t++) {
+        if (started[t]) pthread_join(threads[t], NULL);
+    }
+}
+
+// ============================================================
+// --- BENCHMARK: VARREDURA DE DENSIDADE ---
+// ============================================================
+typedef enum { PADRAO_UNIFORME, PADRAO_BLOCOS } Padrao;
+
+// Zera A fora do padrão: uniforme (cada elemento com prob. d) ou em blocos
+// BR x BC inteiros (cada bloco com prob. d), o caso favorável ao BCSR
+void make_sparse(double* A, int m, int k, double d, Padrao padrao, unsigned* state) {
+    for (size_t i = 0; i < (size_t)m * k; i++) A[i] = 0.0;
+    if (padrao == PADRAO_UNIFORME) {
+        for (size_t i = 0; i < (size_t)m * k; i++) {
+            if ((double)rand_r(state) / RAND_MAX < d) A[i] = 0.5 + (double)(rand_r(state) % 100) * 0.01;
+        }
+    } else {
+        for (int bi = 0; bi < m / BR; bi++) {
+            for (int bj = 0; bj < k / BC; bj++) {
+                if ((double)rand_r(state) / RAND_MAX >= d) continue;
+                for (int r = 0; r < BR; r++)
+                    for (int c = 0; c < BC; c++)
+                        A[(size_t)(bi * BR + r) * k + bj * BC + c] = 0.5 + (double)(rand_r(state) % 100) * 0.01;
+            }
+        }
+    }
+}
+
+double time_kernel(Kernel ker, const void* A, const double* B, double* C, int m, int k, int n, int nthreads) {
+    run_parallel(ker, A, B, C, m, k, n, nthreads);   // Aquecimento
+    double total = 0.0;
+    for (int r = 0; r < NUM_RUNS; r++) {
+        double start = get_time_sec();
+        run_parallel(ker, A, B, C, m, k, n, nthreads);
+        total += get_time_sec() - start;
+    }
+    return total / NUM_RUNS;
+}
+
+double max_rel_diff(const double* X, const double* R, size_t count) {
+    double m = 0.0;
+    for (size_t i = 0; i < count; i++) {
+        double e = fabs(X[i] - R[i]) / (fabs(R[i]) > 1.0 ? fabs(R[i]) : 1.0);
+        if (e > m) m = e;
+    }
+    return m;
+}
+
+// densidades em ordem decrescente; -1 se o esparso perde já na menor delas
+static double crossover(const double* densidades, const int* ganha, int num_dens) {
+    double cross = -1.0;
+    for (int d = num_dens - 1; d >= 0 && ganha[d]; d--) cross = densidades[d];
+    return cross;
+}
+
+int main(int argc, char** argv) {
+    int m = 1024, k = 1024;
+    int n = (argc > 1) ? atoi(argv[1]) : 512;
+    int nthreads = (argc > 2) ? atoi(argv[2]) : (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (nthreads < 1) nthreads = 1;
+    if (nthreads > MAX_THREADS) nthreads = MAX_THREADS;
+    double densidades[] = {1.00, 0.80, 0.65, 0.50, 0.30, 0.20, 0.10, 0.05, 0.02, 0.01, 0.005, 0.001};
+    int num_dens = sizeof(densidades) / sizeof(densidades[0]);
+
+    printf("=== SpMM: ESPARSA x DENSA (CSR e BCSR %dx%d) CONTRA O DENSO ===\n", BR, BC);
+    printf("==========================================================\n");
+    printf("A: %d x %d esparsa | B: %d x %d densa | threads: %d\n\n", m, k, k, n, nthreads);
+
+    double* A = alloc_rect(m, k, "Matriz A");
+    double* B = alloc_rect(k, n, "Matriz B");
+    double* C_ref = alloc_rect(m, n, "Matriz C denso");
+    double* C = alloc_rect(m, n, "Matriz C esparso");
+
+    // O denso não depende da densidade: mede uma vez
+    double t_dense = time_kernel(KER_DENSO, A, B, C_ref, m, k, n, nthreads);
+    printf("Denso (B empacotado, micro-kernel %dx%d): %.4f s (%.2f GFLOPS)\n", MR, NR, t_dense, 2.0 * m * k * n / t_dense * 1e-9);
+
+    const char* nomes_padrao[2] = {"uniforme", "blocos 4x4"};
+    for (int pd = PADRAO_UNIFORME; pd <= PADRAO_BLOCOS; pd++) {
+        unsigned state = SEED;
+        int csr_ganha[num_dens];
+        int bcsr_ganha[num_dens];
+
+        printf("\nPadrão: %s\n", nomes_padrao[pd]);
+        printf("+----------+-----------+------------+--------------+--------------+---------+---------+----------+\n");
+        printf("| Densid.  | nnz       | Preench.   | CSR (s)      | BCSR (s)     | CSR x   | BCSR x  | Erro máx |\n");
+        printf("|          |           | BCSR       |              |              | denso   | denso   |          |\n");
+        printf("+----------+-----------+------------+--------------+--------------+---------+---------+----------+\n");
+
+        for (int d = 0; d < num_dens; d++) {
+            make_sparse(A, m, k, densidades[d], (Padrao)pd, &state);
+
+            // Conversão denso -> esparso (não entra no tempo do kernel)
+            CSR csr = dense_to_csr(A, m, k);
+            BCSR bcsr = dense_to_bcsr(A, m, k);
+
+            double t_csr = time_kernel(KER_CSR, &csr, B, C, m, k, n, nthreads);
+            double t_bcsr = time_kernel(KER_BCSR, &bcsr, B, C, m, k, n, nthreads);
+
+            // Referência: denso com os zeros explícitos
+            run_parallel(KER_DENSO, A, B, C_ref, m, k, n, nthreads);
+            run_parallel(KER_CSR, &csr, B, C, m, k, n, nthreads);
+            double err = max_rel_diff(C, C_ref, (size_t)m * n);
+            run_parallel(KER_BCSR, &bcsr, B, C, m, k, n, nthreads);
+            double err_b = max_rel_diff(C, C_ref, (size_t)m * n);
+            if (err_b > err) err = err_b;
+
+            double fill = bcsr.nblocks ? (double)bcsr.nnz / ((double)bcsr.nblocks * BR * BC) : 0.0;
+            csr_ganha[d] = t_csr < t_dense;
+            bcsr_ganha[d] = t_bcsr < t_dense;
+
+            printf("| %6.1f%%  | %9d | %9.1f%% | %12.5f | %12.5f | %6.2fx | %6.2fx | %8.1e |\n",
+                   densidades[d] * 100, csr.nnz, fill * 100, t_csr, t_bcsr,
+                   t_dense / t_csr, t_dense / t_bcsr, err);
+
+            free_csr(&csr);
+            free_bcsr(&bcsr);
+        }
+        printf("+----------+-----------+------------+--------------+--------------+---------+---------+----------+\n");
+        // Cruzamento: maior densidade d tal que o esparso ganha em toda densidade <= d
+        double cross_csr = crossover(densidades, csr_ganha, num_dens);
+        double cross_bcsr = crossover(densidades, bcsr_ganha, num_dens);
+        if (cross_csr > 0) printf("CSR ganha do denso em toda densidade <= %.1f%%\n", cross_csr * 100);
+        else printf("CSR: sem cruzamento (perde do denso já na menor densidade testada)\n");
+        if (cross_bcsr > 0) printf("BCSR ganha do denso em toda densidade <= %.1f%%\n", cross_bcsr * 100);
+        else printf("BCSR: sem cruzamento (perde do denso já na menor densidade testada)\n");
+    }
+
+    printf("\nPreench. BCSR = não zeros / posições nos blocos guardados (100%% = sem zeros de enchimento)\n");
+    printf("x denso = tempo do denso / tempo do esparso (>1 = esparso mais rápido)\n");
+    printf("Denso = B empacotado (tempo incluído) + micro-kernel %dx%d em registradores, a mesma\n", MR, NR);
+    printf("blocagem do BCSR: o cruzamento mede o ganho da esparsidade, não da blocagem.\n");
+
+    _mm_free(A);
+    _mm_free(B);
+    _mm_free(C_ref);
+    _mm_free(C);
+    _mm_free(dense_bp);
+    return 0;
+}
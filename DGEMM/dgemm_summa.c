@@ -0,0 +1,436 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <string.h>
+#include <math.h>
+#include <immintrin.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#ifdef USE_MPI
+#include <mpi.h>
+#endif
+
+// --- CONFIGURAÇÕES ---
+#define BLOCK_SIZE 32       // Block size do kernel local
+#define KB_SUMMA 64         // Largura do painel transmitido a cada passo
+#define MAX_PROCS 64        // Limite de processos na grade
+#define MAX_STEPS 1024      // Limite de passos registrados
+#define N_PADRAO 2048       // Tamanho padrão do produto
+
+// --- UTILITÁRIOS DE TEMPO (Alta Precisão) ---
+double get_time_sec() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// --- ALOCAÇÃO E INICIALIZAÇÃO ---
+double* alloc_rect(int rows, int cols, const char* name) {
+    double* ptr = (double*)_mm_malloc((size_t)rows * cols * sizeof(double), 64);
+    if (!ptr) {
+        printf("[ERRO] Falha ao alocar %s\n", name);
+        exit(1);
+    }
+    memset(ptr, 0, (size_t)rows * cols * sizeof(double));
+    return ptr;
+}
+
+// Valor global de A/B na posição (i, j): cada processo gera só o seu bloco
+static inline double init_value(int n, int i, int j) {
+    return (double)((((size_t)i * n + j) % 100) + 1) * 0.01;
+}
+
+// --- KERNEL LOCAL: AVX + BLOCKING (retangular, com leading dimensions) ---
+// C[m x n] += A[m x k] * B[k x n]
+void dgemm_avx_block_ld(int m, int k, int n, const double* A, int lda,
+                        const double* B, int ldb, double* C, int ldc) {
+    for (int i_blk = 0; i_blk < m; i_blk += BLOCK_SIZE) {
+        for (int k_blk = 0; k_blk < k; k_blk += BLOCK_SIZE) {
+            for (int j_blk = 0; j_blk < n; j_blk += BLOCK_SIZE) {
+                int i_max = (i_blk + BLOCK_SIZE > m) ? m : i_blk + BLOCK_SIZE;
+                int k_max = (k_blk + BLOCK_SIZE > k) ? k : k_blk + BLOCK_SIZE;
+                int j_max = (j_blk + BLOCK_SIZE > n) ? n : j_blk + BLOCK_SIZE;
+
+                for (int i = i_blk; i < i_max; i++) {
+                    for (int kk = k_blk; kk < k_max; kk++) {
+                        __m256d a_vec = _mm256_set1_pd(A[(size_t)i * lda + kk]);
+                        int j = j_blk;
+                        #ifdef __FMA__
+                        for (; j <= j_max - 8; j += 8) {
+                            __m256d c_vec1 = _mm256_loadu_pd(&C[(size_t)i * ldc + j]);
+                            __m256d b_vec1 = _mm256_loadu_pd(&B[(size_t)kk * ldb + j]);
+                            c_vec1 = _mm256_fmadd_pd(a_vec, b_vec1, c_vec1);
+                            _mm256_storeu_pd(&C[(size_t)i * ldc + j], c_vec1);
+
+                            __m256d c_vec2 = _mm256_loadu_pd(&C[(size_t)i * ldc + j + 4]);
+                            __m256d b_vec2 = _mm256_loadu_pd(&B[(size_t)kk * ldb + j + 4]);
+                            c_vec2 = _mm256_fmadd_pd(a_vec, b_vec2, c_vec2);
+                            _mm256_storeu_pd(&C[(size_t)i * ldc + j + 4], c_vec2);
+                        }
+                        #endif
+                        for (; j <= j_max - 4; j += 4) {
+                            __m256d c_vec = _mm256_loadu_pd(&C[(size_t)i * ldc + j]);
+                            __m256d b_vec = _mm256_loadu_pd(&B[(size_t)kk * ldb + j]);
+                            #ifdef __FMA__
+                            c_vec = _mm256_fmadd_pd(a_vec, b_vec, c_vec);
+                            #else
+                            c_vec = _mm256_add_pd(c_vec, _mm256_mul_pd(a_vec, b_vec));
+                            #endif
+                            _mm256_storeu_pd(&C[(size_t)i * ldc + j], c_vec);
+                        }
+                        for (; j < j_max; j++) {
+                            C[(size_t)i * ldc + j] += A[(size_t)i * lda + kk] * B[(size_t)kk * ldb + j];
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+// --- GRADE 2D DE PROCESSOS ---
+// Processo (r, c) guarda os blocos A_rc, B_rc e C_rc de mloc x nloc.
+// No passo s, a coluna de processos dona das colunas [s*KB, (s+1)*KB) de A
+// transmite o painel ao longo da sua linha; a linha dona das mesmas linhas
+// de B transmite ao longo da sua coluna. Todos fazem C_rc += Apainel * Bpainel.
+typedef struct {
+    int rank, nprocs;
+    int pr, pc;         // Dimensões da grade
+    int my_r, my_c;     // Posição deste processo
+    int n, mloc, nloc;
+    int steps;
+} Grid;
+
+typedef struct {
+    double comm;        // Tempo de transmissão (inclui espera pelos donos)
+    double compute;     // Tempo no kernel local
+} StepTime;
+
+#ifndef USE_MPI
+// --- TRANSPORTE POR MEMÓRIA COMPARTILHADA ---
+// Segmento MAP_SHARED criado antes do fork: 2 slots (double buffer) de
+// painéis de A por linha da grade e de B por coluna, uma barreira
+// pthread entre processos e a área de estatísticas/resultado.
+typedef struct {
+    pthread_barrier_t barrier;
+    double* a_slots;    // [2][pr][mloc * KB]
+    double* b_slots;    // [2][pc][KB * nloc]
+    StepTime* stats;    // [nprocs][steps]
+    double* C_global;   // n x n montada no final para validação
+} Shm;
+
+static Shm* shm;
+
+static void* shm_alloc(size_t bytes) {
+    void* p = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED) {
+        printf("[ERRO] mmap compartilhado de %zu bytes falhou\n", bytes);
+        exit(1);
+    }
+    return p;
+}
+
+static void setup_shm(Grid* g) {
+    shm = (Shm*)shm_alloc(sizeof(Shm));
+    pthread_barrierattr_t attr;
+    pthread_barrierattr_init(&attr);
+    pthread_barrierattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+    pthread_barrier_init(&shm->barrier, &attr, g->nprocs);
+    pthread_barrierattr_destroy(&attr);
+
+    shm->a_slots = (double*)shm_alloc((size_t)2 * g->pr * g->mloc * KB_SUMMA * sizeof(double));
+    shm->b_slots = (double*)shm_alloc((size_t)2 * g->pc * KB_SUMMA * g->nloc * sizeof(double));
+    shm->stats = (StepTime*)shm_alloc((size_t)g->nprocs * g->steps * sizeof(StepTime));
+    shm->C_global = (double*)shm_alloc((size_t)g->n * g->n * sizeof(double));
+}
+
+static void grid_barrier(void) {
+    pthread_barrier_wait(&shm->barrier);
+}
+
+// Com um barreira por passo e dois slots, o slot do passo s só é
+// reescrito no passo s+2, quando todos já passaram da barreira s+1
+// (ou seja, terminaram de copiar o painel s).
+static void bcast_panels(Grid* g, int s, const double* A_loc, const double* B_loc,
+                         double* Apanel, double* Bpanel) {
+    int k0 = s * KB_SUMMA;
+    int owner_c = k0 / g->nloc, ka = k0 % g->nloc;     // Colunas de A: largura nloc
+    int owner_r = k0 / g->mloc, kb = k0 % g->mloc;     // Linhas de B: altura mloc
+    int slot = s % 2;
+    double* a_slot = &shm->a_slots[((size_t)slot * g->pr + g->my_r) * g->mloc * KB_SUMMA];
+    double* b_slot = &shm->b_slots[((size_t)slot * g->pc + g->my_c) * KB_SUMMA * g->nloc];
+
+    if (g->my_c == owner_c) {
+        for (int i = 0; i < g->mloc; i++) {
+            memcpy(&a_slot[(size_t)i * KB_SUMMA], &A_loc[(size_t)i * g->nloc + ka],
+                   KB_SUMMA * sizeof(double));
+        }
+    }
+    if (g->my_r == owner_r) {
+        memcpy(b_slot, &B_loc[(size_t)kb * g->nloc], (size_t)KB_SUMMA * g->nloc * sizeof(double));
+    }
+
+    grid_barrier();
+
+    memcpy(Apanel, a_slot, (size_t)g->mloc * KB_SUMMA * sizeof(double));
+    memcpy(Bpanel, b_slot, (size_t)KB_SUMMA * g->nloc * sizeof(double));
+}
+
+#else
+// --- TRANSPORTE MPI ---
+static MPI_Comm row_comm, col_comm;
+
+static void bcast_panels(Grid* g, int s, const double* A_loc, const double* B_loc,
+                         double* Apanel, double* Bpanel) {
+    int k0 = s * KB_SUMMA;
+    int owner_c = k0 / g->nloc, ka = k0 % g->nloc;
+    int owner_r = k0 / g->mloc, kb = k0 % g->mloc;
+
+    if (g->my_c == owner_c) {
+        for (int i = 0; i < g->mloc; i++) {
+            memcpy(&Apanel[(size_t)i * KB_SUMMA], &A_loc[(size_t)i * g->nloc + ka],
+                   KB_SUMMA * sizeof(double));
+        }
+    }
+    if (g->my_r == owner_r) {
+        memcpy(Bpanel, &B_loc[(size_t)kb * g->nloc], (size_t)KB_SUMMA * g->nloc * sizeof(double));
+    }
+    // row_comm é ordenado por coluna da grade e col_comm por linha
+    MPI_Bcast(Apanel, g->mloc * KB_SUMMA, MPI_DOUBLE, owner_c, row_comm);
+    MPI_Bcast(Bpanel, KB_SUMMA * g->nloc, MPI_DOUBLE, owner_r, col_comm);
+}
+#endif
+
+// --- SUMMA (executado por cada processo) ---
+static void summa_worker(Grid* g, StepTime* times, double* C_loc) {
+    double* A_loc = alloc_rect(g->mloc, g->nloc, "A local");
+    double* B_loc = alloc_rect(g->mloc, g->nloc, "B local");
+    double* Apanel = alloc_rect(g->mloc, KB_SUMMA, "Painel A");
+    double* Bpanel = alloc_rect(KB_SUMMA, g->nloc, "Painel B");
+
+    int row0 = g->my_r * g->mloc, col0 = g->my_c * g->nloc;
+    for (int i = 0; i < g->mloc; i++) {
+        for (int j = 0; j < g->nloc; j++) {
+            A_loc[(size_t)i * g->nloc + j] = init_value(g->n, row0 + i, col0 + j);
+            B_loc[(size_t)i * g->nloc + j] = init_value(g->n, row0 + i, col0 + j);
+        }
+    }
+
+    for (int s = 0; s < g->steps; s++) {
+        double t0 = get_time_sec();
+        bcast_panels(g, s, A_loc, B_loc, Apanel, Bpanel);
+        double t1 = get_time_sec();
+        dgemm_avx_block_ld(g->mloc, KB_SUMMA, g->nloc, Apanel, KB_SUMMA, Bpanel, g->nloc,
+                           C_loc, g->nloc);
+        double t2 = get_time_sec();
+        times[s].comm = t1 - t0;
+        times[s].compute = t2 - t1;
+    }
+
+    _mm_free(A_loc);
+    _mm_free(B_loc);
+    _mm_free(Apanel);
+    _mm_free(Bpanel);
+}
+
+// Grade mais quadrada possível: pr <= pc, pr * pc = P
+static void choose_grid(int P, int* pr, int* pc) {
+    *pr = 1;
+    for (int d = 1; d * d <= P; d++) {
+        if (P % d == 0) *pr = d;
+    }
+    *pc = P / *pr;
+}
+
+// --- RELATÓRIO (rank 0) ---
+static void report(Grid* g, StepTime* all, double wall, double serial_gflops, double err) {
+    printf("\n+-------+---------------------------+---------------------------+\n");
+    printf("| Passo | Comunicação (ms)          | Cálculo (ms)              |\n");
+    printf("|       |   média    |    máx       |   média    |    máx       |\n");
+    printf("+-------+---------------------------+---------------------------+\n");
+
+    double comm_tot = 0.0, comp_tot = 0.0;
+    for (int s = 0; s < g->steps; s++) {
+        double cm = 0, cx = 0, pm = 0, px = 0;
+        for (int p = 0; p < g->nprocs; p++) {
+            StepTime t = all[(size_t)p * g->steps + s];
+            cm += t.comm; pm += t.compute;
+            if (t.comm > cx) cx = t.comm;
+            if (t.compute > px) px = t.compute;
+        }
+        cm /= g->nprocs; pm /= g->nprocs;
+        comm_tot += cx; comp_tot += px;
+        printf("| %5d | %10.3f | %12.3f | %10.3f | %12.3f |\n",
+               s, cm * 1e3, cx * 1e3, pm * 1e3, px * 1e3);
+    }
+    printf("+-------+---------------------------+---------------------------+\n");
+
+    double ops = 2.0 * (double)g->n * g->n * g->n;
+    double gflops = ops / wall * 1e-9;
+    printf("\nTempo total:           %.3f s\n", wall);
+    printf("Soma dos máximos:      comunicação %.3f s | cálculo %.3f s (%.1f%% comunicação)\n",
+           comm_tot, comp_tot, comm_tot / (comm_tot + comp_tot) * 100.0);
+    printf("Desempenho:            %.2f GFLOPS com %d processos\n", gflops, g->nprocs);
+    if (serial_gflops > 0) {
+        printf("Kernel local (1 proc): %.2f GFLOPS -> eficiência paralela %.1f%%\n",
+               serial_gflops, gflops / (serial_gflops * g->nprocs) * 100.0);
+    }
+    printf("Erro máximo (amostra): %.2e\n", err);
+}
+
+// Confere 64 elementos de C contra o produto escalar direto
+static double check_sample(int n, const double* C) {
+    double worst = 0.0;
+    srand(7);
+    for (int s = 0; s < 64; s++) {
+        int i = rand() % n, j = rand() % n;
+        double ref = 0.0;
+        for (int k = 0; k < n; k++) ref += init_value(n, i, k) * init_value(n, k, j);
+        double d = fabs(C[(size_t)i * n + j] - ref) / fabs(ref);
+        if (d > worst) worst = d;
+    }
+    return worst;
+}
+
+// Desempenho do kernel local sozinho, no tamanho do bloco de um processo
+static double local_kernel_gflops(Grid* g) {
+    double* A = alloc_rect(g->mloc, KB_SUMMA, "A");
+    double* B = alloc_rect(KB_SUMMA, g->nloc, "B");
+    double* C = alloc_rect(g->mloc, g->nloc, "C");
+    double start = get_time_sec();
+    for (int s = 0; s < g->steps; s++) {
+        dgemm_avx_block_ld(g->mloc, KB_SUMMA, g->nloc, A, KB_SUMMA, B, g->nloc, C, g->nloc);
+    }
+    double elapsed = get_time_sec() - start;
+    _mm_free(A); _mm_free(B); _mm_free(C);
+    return 2.0 * g->mloc * (double)g->nloc * KB_SUMMA * g->steps / elapsed * 1e-9;
+}
+
+int main(int argc, char** argv) {
+    Grid g;
+    int n_req = (argc > 2) ? atoi(argv[2]) : N_PADRAO;
+
+#ifdef USE_MPI
+    MPI_Init(&argc, &argv);
+    MPI_Comm_rank(MPI_COMM_WORLD, &g.rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &g.nprocs);
+#else
+    g.rank = 0;
+    g.nprocs = (argc > 1) ? atoi(argv[1]) : (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (g.nprocs < 1) g.nprocs = 1;
+#endif
+    if (g.nprocs > MAX_PROCS) {
+        if (g.rank == 0) printf("[ERRO] Máximo de %d processos\n", MAX_PROCS);
+        return 1;
+    }
+
+    choose_grid(g.nprocs, &g.pr, &g.pc);
+    // n múltiplo de pr*KB e pc*KB: painéis nunca cruzam blocos de processos
+    int unit = g.pr * g.pc * KB_SUMMA;
+    g.n = (n_req + unit - 1) / unit * unit;
+    g.mloc = g.n / g.pr;
+    g.nloc = g.n / g.pc;
+    g.steps = g.n / KB_SUMMA;
+    if (g.steps > MAX_STEPS) {
+        if (g.rank == 0) printf("[ERRO] Passos demais (%d)\n", g.steps);
+        return 1;
+    }
+
+    if (g.rank == 0) {
+        printf("=== DGEMM DISTRIBUÍDO: SUMMA EM GRADE 2D ===\n");
+        printf("==========================================================\n");
+#ifdef USE_MPI
+        printf("Transporte:     MPI (MPI_Bcast por linha/coluna da grade)\n");
+#else
+        printf("Transporte:     memória compartilhada (fork + mmap, double buffer)\n");
+#endif
+        printf("Processos:      %d (grade %d x %d)\n", g.nprocs, g.pr, g.pc);
+        printf("Matriz:         %d x %d (pedido %d)\n", g.n, g.n, n_req);
+        printf("Bloco local:    %d x %d | painel KB = %d | %d passos\n",
+               g.mloc, g.nloc, KB_SUMMA, g.steps);
+    }
+
+    StepTime* times = (StepTime*)calloc(g.steps, sizeof(StepTime));
+
+#ifdef USE_MPI
+    g.my_r = g.rank / g.pc;
+    g.my_c = g.rank % g.pc;
+    MPI_Comm_split(MPI_COMM_WORLD, g.my_r, g.my_c, &row_comm);
+    MPI_Comm_split(MPI_COMM_WORLD, g.my_c, g.my_r, &col_comm);
+
+    double* C_loc = alloc_rect(g.mloc, g.nloc, "C local");
+    MPI_Barrier(MPI_COMM_WORLD);
+    double start = MPI_Wtime();
+    summa_worker(&g, times, C_loc);
+    MPI_Barrier(MPI_COMM_WORLD);
+    double wall = MPI_Wtime() - start;
+
+    StepTime* all = NULL;
+    double* C_all = NULL;
+    if (g.rank == 0) {
+        all = (StepTime*)malloc((size_t)g.nprocs * g.steps * sizeof(StepTime));
+        C_all = alloc_rect(g.nprocs, g.mloc * g.nloc, "C reunida");
+    }
+    MPI_Gather(times, g.steps * 2, MPI_DOUBLE, all, g.steps * 2, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+    MPI_Gather(C_loc, g.mloc * g.nloc, MPI_DOUBLE, C_all, g.mloc * g.nloc, MPI_DOUBLE, 0, MPI_COMM_WORLD);
+
+    if (g.rank == 0) {
+        double* C = alloc_rect(g.n, g.n, "C global");
+        for (int p = 0; p < g.nprocs; p++) {
+            int r = p / g.pc, c = p % g.pc;
+            for (int i = 0; i < g.mloc; i++) {
+                memcpy(&C[(size_t)(r * g.mloc + i) * g.n + c * g.nloc],
+                       &C_all[(size_t)p * g.mloc * g.nloc + (size_t)i * g.nloc],
+                       g.nloc * sizeof(double));
+            }
+        }
+        report(&g, all, wall, local_kernel_gflops(&g), check_sample(g.n, C));
+        _mm_free(C);
+        _mm_free(C_all);
+        free(all);
+    }
+    _mm_free(C_loc);
+    MPI_Comm_free(&row_comm);
+    MPI_Comm_free(&col_comm);
+    MPI_Finalize();
+#else
+    setup_shm(&g);
+    double start = get_time_sec();
+
+    for (int p = 0; p < g.nprocs; p++) {
+        pid_t pid = (p == g.nprocs - 1) ? 0 : fork();
+        if (pid < 0) {
+            printf("[ERRO] fork falhou\n");
+            return 1;
+        }
+        if (pid == 0) {
+            // Filhos ficam com os ranks 0..P-2, o pai com P-1
+            g.rank = p;
+            g.my_r = p / g.pc;
+            g.my_c = p % g.pc;
+            double* C_loc = alloc_rect(g.mloc, g.nloc, "C local");
+            summa_worker(&g, times, C_loc);
+
+            memcpy(&shm->stats[(size_t)p * g.steps], times, g.steps * sizeof(StepTime));
+            for (int i = 0; i < g.mloc; i++) {
+                memcpy(&shm->C_global[(size_t)(g.my_r * g.mloc + i) * g.n + g.my_c * g.nloc],
+                       &C_loc[(size_t)i * g.nloc], g.nloc * sizeof(double));
+            }
+            _mm_free(C_loc);
+            if (p != g.nprocs - 1) _exit(0);
+            break;
+        }
+    }
+
+    while (wait(NULL) > 0);
+    double wall = get_time_sec() - start;
+    report(&g, shm->stats, wall, local_kernel_gflops(&g), check_sample(g.n, shm->C_global));
+#endif
+
+    free(times);
+    return 0;
+}
@@ -0,0 +1,338 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <string.h>
+#include <immintrin.h>
+#include <stdint.h>
+#include <unistd.h>
+
+// --- CONFIGURAÇÕES ---
+#define BLOCK_SIZE 32   // Otimizado para L1 Cache
+#define NUM_RUNS 5      // Execuções para média estatística
+#define WARMUP_RUNS 1   // Aquecimento de cache
+
+// Limites dentro de um bloco diagonal
+#define BLOCO_CHEIO 0   // Bloco inteiro
+#define BLOCO_TRI_J 1   // Apenas j <= i (triângulo inferior de C, SYRK)
+#define BLOCO_TRI_K 2   // Apenas k <= i (triângulo inferior de A, TRMM)
+
+// --- UTILITÁRIOS DE TEMPO (Alta Precisão) ---
+double get_time_sec() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// --- ALOCAÇÃO E INICIALIZAÇÃO ---
+double* alloc_matrix(int n, const char* name) {
+    double* ptr = (double*)_mm_malloc(n * n * sizeof(double), 64);
+    if (!ptr) {
+        printf("[ERRO] Falha ao alocar %s\n", name);
+        exit(1);
+    }
+
+    for (int i = 0; i < n * n; i++) {
+        ptr[i] = (double)((i % 100) + 1) * 0.01;
+    }
+    return ptr;
+}
+
+void clean_matrix(double* C, int n) {
+    memset(C, 0, n * n * sizeof(double));
+}
+
+// Triangular inferior bem condicionada para TRMM/TRSM (diagonal dominante)
+double* alloc_lower(int n, const char* name) {
+    double* L = alloc_matrix(n, name);
+    for (int i = 0; i < n; i++) {
+        for (int j = i + 1; j < n; j++) L[i * n + j] = 0.0;
+        L[i * n + i] = (double)n;
+    }
+    return L;
+}
+
+// --- KERNEL DE BLOCO (mesmo corpo SIMD de dgemm_avx_block) ---
+// C[i][j] += (ou -=) A[i][k] * B[k][j] para um bloco mb x kb x nb com
+// leading dimensions próprias; 'modo' corta o bloco diagonal.
+static void block_kernel(int mb, int kb, int nb,
+                         const double* A, int lda, const double* B, int ldb,
+                         double* C, int ldc, int modo, int sub) {
+    for (int i = 0; i < mb; i++) {
+        int j_max = (modo == BLOCO_TRI_J && i + 1 < nb) ? i + 1 : nb;
+        int k_max = (modo == BLOCO_TRI_K && i + 1 < kb) ? i + 1 : kb;
+
+        for (int k = 0; k < k_max; k++) {
+            double a = sub ? -A[i * lda + k] : A[i * lda + k];
+            __m256d a_vec = _mm256_set1_pd(a);
+
+            int j = 0;
+            #ifdef __FMA__
+            for (; j <= j_max - 8; j += 8) {
+                __m256d c_vec1 = _mm256_loadu_pd(&C[i * ldc + j]);
+                __m256d b_vec1 = _mm256_loadu_pd(&B[k * ldb + j]);
+                c_vec1 = _mm256_fmadd_pd(a_vec, b_vec1, c_vec1);
+                _mm256_storeu_pd(&C[i * ldc + j], c_vec1);
+
+                __m256d c_vec2 = _mm256_loadu_pd(&C[i * ldc + j + 4]);
+                __m256d b_vec2 = _mm256_loadu_pd(&B[k * ldb + j + 4]);
+                c_vec2 = _mm256_fmadd_pd(a_vec, b_vec2, c_vec2);
+                _mm256_storeu_pd(&C[i * ldc + j + 4], c_vec2);
+            }
+            #endif
+
+            for (; j <= j_max - 4; j += 4) {
+                __m256d c_vec = _mm256_loadu_pd(&C[i * ldc + j]);
+                __m256d b_vec = _mm256_loadu_pd(&B[k * ldb + j]);
+                #ifdef __FMA__
+                c_vec = _mm256_fmadd_pd(a_vec, b_vec, c_vec);
+                #else
+                c_vec = _mm256_add_pd(c_vec, _mm256_mul_pd(a_vec, b_vec));
+                #endif
+                _mm256_storeu_pd(&C[i * ldc + j], c_vec);
+            }
+
+            for (; j < j_max; j++) {
+                C[i * ldc + j] += a * B[k * ldb + j];
+            }
+        }
+    }
+}
+
+// --- GEMM (referência "força bruta") ---
+void dgemm_avx_block(int n, double* A, double* B, double* C) {
+    for (int i_blk = 0; i_blk < n; i_blk += BLOCK_SIZE) {
+        for (int k_blk = 0; k_blk < n; k_blk += BLOCK_SIZE) {
+            for (int j_blk = 0; j_blk < n; j_blk += BLOCK_SIZE) {
+                int mb = (i_blk + BLOCK_SIZE > n) ? n - i_blk : BLOCK_SIZE;
+                int kb = (k_blk + BLOCK_SIZE > n) ? n - k_blk : BLOCK_SIZE;
+                int nb = (j_blk + BLOCK_SIZE > n) ? n - j_blk : BLOCK_SIZE;
+                block_kernel(mb, kb, nb, &A[i_blk * n + k_blk], n, &B[k_blk * n + j_blk], n,
+                             &C[i_blk * n + j_blk], n, BLOCO_CHEIO, 0);
+            }
+        }
+    }
+}
+
+// A*Aᵀ pelo caminho completo: transpõe A e chama o GEMM quadrado
+void syrk_via_gemm(int n, double* A, double* At, double* C) {
+    for (int i = 0; i < n; i++)
+        for (int j = 0; j < n; j++)
+            At[j * n + i] = A[i * n + j];
+    dgemm_avx_block(n, A, At, C);
+}
+
+// --- SYRK: C(inferior) += A * Aᵀ ---
+// Para cada bloco (J, K) transpõe A[J, K] uma vez num buffer e reaproveita
+// para todos os blocos I >= J. Blocos acima da diagonal não são calculados
+// e o bloco diagonal para em j <= i.
+void dsyrk_lower(int n, double* A, double* C) {
+    double T[BLOCK_SIZE * BLOCK_SIZE] __attribute__((aligned(64)));
+
+    for (int j_blk = 0; j_blk < n; j_blk += BLOCK_SIZE) {
+        int nb = (j_blk + BLOCK_SIZE > n) ? n - j_blk : BLOCK_SIZE;
+        for (int k_blk = 0; k_blk < n; k_blk += BLOCK_SIZE) {
+            int kb = (k_blk + BLOCK_SIZE > n) ? n - k_blk : BLOCK_SIZE;
+
+            // T[k][j] = A[j_blk + j][k_blk + k]
+            for (int j = 0; j < nb; j++)
+                for (int k = 0; k < kb; k++)
+                    T[k * BLOCK_SIZE + j] = A[(j_blk + j) * n + k_blk + k];
+
+            for (int i_blk = j_blk; i_blk < n; i_blk += BLOCK_SIZE) {
+                int mb = (i_blk + BLOCK_SIZE > n) ? n - i_blk : BLOCK_SIZE;
+                block_kernel(mb, kb, nb, &A[i_blk * n + k_blk], n, T, BLOCK_SIZE,
+                             &C[i_blk * n + j_blk], n,
+                             (i_blk == j_blk) ? BLOCO_TRI_J : BLOCO_CHEIO, 0);
+            }
+        }
+    }
+}
+
+// --- TRMM: C += L * B (L triangular inferior, apenas o triângulo é lido) ---
+// Blocos K > I de L são zero e pulados; no bloco diagonal k <= i.
+void dtrmm_lower(int n, double* L, double* B, double* C) {
+    for (int i_blk = 0; i_blk < n; i_blk += BLOCK_SIZE) {
+        int mb = (i_blk + BLOCK_SIZE > n) ? n - i_blk : BLOCK_SIZE;
+        for (int k_blk = 0; k_blk <= i_blk; k_blk += BLOCK_SIZE) {
+            int kb = (k_blk + BLOCK_SIZE > n) ? n - k_blk : BLOCK_SIZE;
+            for (int j_blk = 0; j_blk < n; j_blk += BLOCK_SIZE) {
+                int nb = (j_blk + BLOCK_SIZE > n) ? n - j_blk : BLOCK_SIZE;
+                block_kernel(mb, kb, nb, &L[i_blk * n + k_blk], n, &B[k_blk * n + j_blk], n,
+                             &C[i_blk * n + j_blk], n,
+                             (k_blk == i_blk) ? BLOCO_TRI_K : BLOCO_CHEIO, 0);
+            }
+        }
+    }
+}
+
+// --- TRSM: resolve L * X = B (X sobrescreve B) ---
+// Substituição progressiva por blocos: X_I = B_I - sum_{K<I} L_IK X_K com o
+// kernel de bloco em modo subtração, depois o bloco diagonal linha a linha
+// (cada linha é uma operação vetorial sobre as n colunas).
+void dtrsm_lower(int n, double* L, double* B) {
+    for (int i_blk = 0; i_blk < n; i_blk += BLOCK_SIZE) {
+        int mb = (i_blk + BLOCK_SIZE > n) ? n - i_blk : BLOCK_SIZE;
+
+        for (int k_blk = 0; k_blk < i_blk; k_blk += BLOCK_SIZE) {
+            for (int j_blk = 0; j_blk < n; j_blk += BLOCK_SIZE) {
+                int nb = (j_blk + BLOCK_SIZE > n) ? n - j_blk : BLOCK_SIZE;
+                block_kernel(mb, BLOCK_SIZE, nb, &L[i_blk * n + k_blk], n,
+                             &B[k_blk * n + j_blk], n, &B[i_blk * n + j_blk], n,
+                             BLOCO_CHEIO, 1);
+            }
+        }
+
+        // Bloco diagonal
+        for (int i = i_blk; i < i_blk + mb; i++) {
+            double* x = &B[i * n];
+            for (int k = i_blk; k < i; k++) {
+                __m256d a_vec = _mm256_set1_pd(-L[i * n + k]);
+                const double* xk = &B[k * n];
+                int j = 0;
+                for (; j <= n - 4; j += 4) {
+                    __m256d c_vec = _mm256_loadu_pd(&x[j]);
+                    #ifdef __FMA__
+                    c_vec = _mm256_fmadd_pd(a_vec, _mm256_loadu_pd(&xk[j]), c_vec);
+                    #else
+                    c_vec = _mm256_add_pd(c_vec, _mm256_mul_pd(a_vec, _mm256_loadu_pd(&xk[j])));
+                    #endif
+                    _mm256_storeu_pd(&x[j], c_vec);
+                }
+                for (; j < n; j++) x[j] -= L[i * n + k] * xk[j];
+            }
+            double inv = 1.0 / L[i * n + i];
+            __m256d inv_vec = _mm256_set1_pd(inv);
+            int j = 0;
+            for (; j <= n - 4; j += 4) {
+                _mm256_storeu_pd(&x[j], _mm256_mul_pd(_mm256_loadu_pd(&x[j]), inv_vec));
+            }
+            for (; j < n; j++) x[j] *= inv;
+        }
+    }
+}
+
+// --- VALIDAÇÃO ---
+double max_rel_diff_lower(const double* X, const double* Y, int n, int only_lower) {
+    double diff = 0.0;
+    for (int i = 0; i < n; i++) {
+        int j_max = only_lower ? i + 1 : n;
+        for (int j = 0; j < j_max; j++) {
+            double ref = Y[i * n + j];
+            double d = X[i * n + j] - ref;
+            if (d < 0) d = -d;
+            if (ref < 0) ref = -ref;
+            if (ref > 0) d /= ref;
+            if (d > diff) diff = d;
+        }
+    }
+    return diff;
+}
+
+// --- BENCHMARK ---
+typedef struct {
+    double time;
+    double gflops;   // FLOPs úteis / tempo
+} BenchResult;
+
+// 'setup' reinicia as saídas antes de cada execução (fora do tempo)
+typedef void (*BenchFn)(int n, double** m);
+typedef void (*SetupFn)(int n, double** m);
+
+BenchResult run_benchmark(BenchFn func, SetupFn setup, int n, double** m, double useful_flops) {
+    for (int w = 0; w < WARMUP_RUNS; w++) {
+        setup(n, m);
+        func(n, m);
+    }
+
+    double total_time = 0.0;
+    for (int r = 0; r < NUM_RUNS; r++) {
+        setup(n, m);
+        double start = get_time_sec();
+        func(n, m);
+        total_time += get_time_sec() - start;
+    }
+
+    BenchResult res;
+    res.time = total_time / NUM_RUNS;
+    res.gflops = useful_flops / res.time * 1e-9;
+    return res;
+}
+
+// m[0] = A/L, m[1] = B, m[2] = C, m[3] = auxiliar, m[4] = cópia de B
+static void setup_clean_c(int n, double** m) { clean_matrix(m[2], n); }
+static void setup_restore_b(int n, double** m) { memcpy(m[1], m[4], (size_t)n * n * sizeof(double)); }
+
+static void bench_syrk_gemm(int n, double** m) { syrk_via_gemm(n, m[0], m[3], m[2]); }
+static void bench_syrk(int n, double** m) { dsyrk_lower(n, m[0], m[2]); }
+static void bench_trmm_gemm(int n, double** m) { dgemm_avx_block(n, m[0], m[1], m[2]); }
+static void bench_trmm(int n, double** m) { dtrmm_lower(n, m[0], m[1], m[2]); }
+static void bench_trsm(int n, double** m) { dtrsm_lower(n, m[0], m[1]); }
+
+int main() {
+    int sizes[] = {128, 256, 512, 1024};
+    int num_sizes = sizeof(sizes) / sizeof(sizes[0]);
+
+    printf("=== BENCHMARK: SYRK / TRMM / TRSM vs GEMM COMPLETO ===\n");
+    printf("==========================================================\n");
+    printf("Block size: %d | GFLOPS contados sobre FLOPs úteis:\n", BLOCK_SIZE);
+    printf("  SYRK: n²(n+1) (apenas triângulo inferior de A*Aᵀ)\n");
+    printf("  TRMM: n²(n+1) (L triangular inferior)\n");
+    printf("  TRSM: n³      (substituição progressiva, n colunas)\n");
+    printf("O GEMM completo faz 2n³ FLOPs para o mesmo resultado útil.\n\n");
+
+    printf("+--------+----------------------------+----------------------------+------------+\n");
+    printf("| Tamanho| SYRK (GFLOPS úteis)        | TRMM (GFLOPS úteis)        | TRSM       |\n");
+    printf("|        | via GEMM | dedicado | ganho | via GEMM | dedicado | ganho | (GFLOPS)   |\n");
+    printf("+--------+----------------------------+----------------------------+------------+\n");
+
+    for (int s = 0; s < num_sizes; s++) {
+        int n = sizes[s];
+        double* m[5];
+        m[0] = alloc_lower(n, "Matriz L");
+        m[1] = alloc_matrix(n, "Matriz B");
+        m[2] = alloc_matrix(n, "Matriz C");
+        m[3] = alloc_matrix(n, "Auxiliar");
+        m[4] = alloc_matrix(n, "Cópia de B");
+        double* A = alloc_matrix(n, "Matriz A");
+        double* ref = alloc_matrix(n, "Referência");
+        double nn = (double)n;
+
+        // SYRK usa A cheia
+        double* L = m[0];
+        m[0] = A;
+        BenchResult syrk_g = run_benchmark(bench_syrk_gemm, setup_clean_c, n, m, nn * nn * (nn + 1));
+        memcpy(ref, m[2], (size_t)n * n * sizeof(double));
+        BenchResult syrk_d = run_benchmark(bench_syrk, setup_clean_c, n, m, nn * nn * (nn + 1));
+        double err_syrk = max_rel_diff_lower(m[2], ref, n, 1);
+        m[0] = L;
+
+        // TRMM: o GEMM completo multiplica também os zeros acima da diagonal
+        BenchResult trmm_g = run_benchmark(bench_trmm_gemm, setup_clean_c, n, m, nn * nn * (nn + 1));
+        memcpy(ref, m[2], (size_t)n * n * sizeof(double));
+        BenchResult trmm_d = run_benchmark(bench_trmm, setup_clean_c, n, m, nn * nn * (nn + 1));
+        double err_trmm = max_rel_diff_lower(m[2], ref, n, 0);
+
+        // TRSM: resolve L X = L*B e compara X com B
+        memcpy(m[4], m[2], (size_t)n * n * sizeof(double));
+        BenchResult trsm = run_benchmark(bench_trsm, setup_restore_b, n, m, nn * nn * nn);
+        double* B_orig = alloc_matrix(n, "B original");
+        double err_trsm = max_rel_diff_lower(m[1], B_orig, n, 0);
+
+        printf("| %6d | %8.2f | %8.2f | %4.2fx | %8.2f | %8.2f | %4.2fx | %10.2f |\n",
+               n, syrk_g.gflops, syrk_d.gflops, syrk_g.time / syrk_d.time,
+               trmm_g.gflops, trmm_d.gflops, trmm_g.time / trmm_d.time, trsm.gflops);
+        if (err_syrk > 1e-12 || err_trmm > 1e-12 || err_trsm > 1e-10) {
+            printf("[ERRO] Divergência em %dx%d: SYRK %.1e, TRMM %.1e, TRSM %.1e\n",
+                   n, n, err_syrk, err_trmm, err_trsm);
+        }
+
+        for (int i = 0; i < 5; i++) _mm_free(m[i]);
+        _mm_free(A);
+        _mm_free(ref);
+        _mm_free(B_orig);
+    }
+    printf("+--------+----------------------------+----------------------------+------------+\n");
+    printf("\nGanho = tempo do GEMM completo / tempo da rotina estruturada (ideal ~2x)\n");
+
+    return 0;
+}
@@ -0,0 +1,428 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <string.h>
+#include <immintrin.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+
+// --- CONFIGURAÇÕES ---
+#define BLOCK_SIZE 32           // Block size otimizado para L1 Cache
+#define MAX_THREADS 64          // Limite do pool
+#define SPIN_ITERS 4000         // Voltas com pause antes de dormir (~alguns µs)
+#define EMPTY_CALLS 20000       // Despachos vazios para medir a latência
+#define BARRIER_ROUNDS 20000    // Barreiras por medição
+#define MIN_BENCH_SEC 0.2       // Tempo mínimo de medição por tamanho
+
+// --- UTILITÁRIOS DE TEMPO (Alta Precisão) ---
+double get_time_sec() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// --- ALOCAÇÃO E INICIALIZAÇÃO ---
+double* alloc_matrix(int n, const char* name) {
+    double* ptr = (double*)_mm_malloc((size_t)n * n * sizeof(double), 64);
+    if (!ptr) {
+        printf("[ERRO] Falha ao alocar %s\n", name);
+        exit(1);
+    }
+
+    for (size_t i = 0; i < (size_t)n * n; i++) {
+        ptr[i] = (double)((i % 100) + 1) * 0.01;
+    }
+    return ptr;
+}
+
+void clean_matrix(double* C, int n) {
+    memset(C, 0, (size_t)n * n * sizeof(double));
+}
+
+// ============================================================
+// --- POOL DE THREADS PERSISTENTE ---
+// ============================================================
+// A thread chamadora é o tid 0 e trabalha junto; os workers 1..n-1 ficam
+// vivos entre chamadas. O despacho é um contador de geração: o worker gira
+// (pause) por spin_limit voltas esperando a geração mudar e só então dorme
+// na variável de condição. Quem despacha só faz o broadcast se alguém dormiu,
+// então chamadas seguidas não passam pelo kernel. O join é um contador
+// atômico de workers que terminaram.
+typedef void (*PoolFn)(void* arg, int tid, int nthreads);
+
+typedef struct {
+    int nthreads;                       // Inclui a thread chamadora
+    int spin_limit;                     // SPIN_ITERS, ou 0 se há mais threads que núcleos
+    pthread_t threads[MAX_THREADS];
+    PoolFn fn;
+    void* arg;
+    atomic_uint gen;                    // Incrementado a cada despacho
+    atomic_int done;                    // Workers que terminaram o job atual
+    atomic_int sleepers;                // Workers dormindo na condição
+    atomic_int stop;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    // Barreira centralizada com inversão de sentido
+    atomic_int bar_count;
+    atomic_int bar_sense;
+    int local_sense[MAX_THREADS];
+} ThreadPool;
+
+typedef struct {
+    ThreadPool* pool;
+    int tid;
+} WorkerArg;
+
+static WorkerArg worker_args[MAX_THREADS];
+
+// Espera ativa curta e depois cede o núcleo (nunca dorme: é o lado do join)
+static inline void spin_wait_pause(const ThreadPool* pool, int* spins) {
+    if (*spins < pool->spin_limit) {
+        _mm_pause();
+        (*spins)++;
+    } else {
+        sched_yield();
+    }
+}
+
+static unsigned wait_generation(ThreadPool* pool, unsigned seen) {
+    for (int s = 0; s < pool->spin_limit; s++) {
+        unsigned g = atomic_load_explicit(&pool->gen, memory_order_acquire);
+        if (g != seen) return g;
+        _mm_pause();
+    }
+
+    // Estaciona: sleepers é publicado antes de reler gen (par de seq_cst
+    // com o despacho, que escreve gen e depois lê sleepers)
+    pthread_mutex_lock(&pool->lock);
+    atomic_fetch_add(&pool->sleepers, 1);
+    unsigned g;
+    while ((g = atomic_load(&pool->gen)) == seen) {
+        pthread_cond_wait(&pool->cond, &pool->lock);
+    }
+    atomic_fetch_sub(&pool->sleepers, 1);
+    pthread_mutex_unlock(&pool->lock);
+    return g;
+}
+
+static void* pool_worker(void* p) {
+    WorkerArg* wa = (WorkerArg*)p;
+    ThreadPool* pool = wa->pool;
+    unsigned seen = 0;
+
+    for (;;) {
+        seen = wait_generation(pool, seen);
+        if (atomic_load_explicit(&pool->stop, memory_order_acquire)) break;
+        pool->fn(pool->arg, wa->tid, pool->nthreads);
+        atomic_fetch_add_explicit(&pool->done, 1, memory_order_release);
+    }
+    return NULL;
+}
+
+static void pool_wake(ThreadPool* pool) {
+    atomic_fetch_add(&pool->gen, 1);
+    if (atomic_load(&pool->sleepers) > 0) {
+        pthread_mutex_lock(&pool->lock);
+        pthread_cond_broadcast(&pool->cond);
+        pthread_mutex_unlock(&pool->lock);
+    }
+}
+
+void pool_init(ThreadPool* pool, int nthreads) {
+    if (nthreads < 1) nthreads = 1;
+    if (nthreads > MAX_THREADS) nthreads = MAX_THREADS;
+    memset(pool, 0, sizeof(*pool));
+    pool->nthreads = nthreads;
+    // Sobreinscrito, girar só rouba o núcleo de quem tem trabalho
+    pool->spin_limit = (nthreads <= sysconf(_SC_NPROCESSORS_ONLN)) ? SPIN_ITERS : 0;
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->cond, NULL);
+
+    for (int t = 1; t < nthreads; t++) {
+        worker_args[t].pool = pool;
+        worker_args[t].tid = t;
+        if (pthread_create(&pool->threads[t], NULL, pool_worker, &worker_args[t]) != 0) {
+            printf("[ERRO] Falha ao criar worker %d do pool\n", t);
+            exit(1);
+        }
+    }
+}
+
+// Executa fn(arg, tid, nthreads) em todas as threads e retorna quando todas terminam
+void pool_run(ThreadPool* pool, PoolFn fn, void* arg) {
+    pool->fn = fn;
+    pool->arg = arg;
+    atomic_store_explicit(&pool->done, 0, memory_order_relaxed);
+    pool_wake(pool);
+
+    fn(arg, 0, pool->nthreads);
+
+    int spins = 0;
+    while (atomic_load_explicit(&pool->done, memory_order_acquire) < pool->nthreads - 1) {
+        spin_wait_pause(pool, &spins);
+    }
+}
+
+// Barreira leve para uso dentro de um job (todas as threads do pool)
+void pool_barrier(ThreadPool* pool, int tid) {
+    int sense = !pool->local_sense[tid];
+    pool->local_sense[tid] = sense;
+
+    if (atomic_fetch_add_explicit(&pool->bar_count, 1, memory_order_acq_rel) == pool->nthreads - 1) {
+        atomic_store_explicit(&pool->bar_count, 0, memory_order_relaxed);
+        atomic_store_explicit(&pool->bar_sense, sense, memory_order_release);
+    } else {
+        int spins = 0;
+        while (atomic_load_explicit(&pool->bar_sense, memory_order_acquire) != sense) {
+            spin_wait_pause(pool, &spins);
+        }
+    }
+}
+
+void pool_destroy(ThreadPool* pool) {
+    atomic_store(&pool->stop, 1);
+    pool_wake(pool);
+    for (int t = 1; t < pool->nthreads; t++) pthread_join(pool->threads[t], NULL);
+    pthread_mutex_destroy(&pool->lock);
+    pthread_cond_destroy(&pool->cond);
+}
+
+// ============================================================
+// --- DGEMM AVX + BLOCKING PARALELO ---
+// ============================================================
+// Mesmo corpo de dgemm_avx_block, restrito às linhas [row_begin, row_end)
+void dgemm_avx_block_rows(int n, double* A, double* B, double* C, int row_begin, int row_end) {
+    for (int i_blk = row_begin; i_blk < row_end; i_blk += BLOCK_SIZE) {
+        for (int k_blk = 0; k_blk < n; k_blk += BLOCK_SIZE) {
+            for (int j_blk = 0; j_blk < n; j_blk += BLOCK_SIZE) {
+
+                int i_max = (i_blk + BLOCK_SIZE > row_end) ? row_end : i_blk + BLOCK_SIZE;
+                int k_max = (k_blk + BLOCK_SIZE > n) ? n : k_blk + BLOCK_SIZE;
+                int j_max = (j_blk + BLOCK_SIZE > n) ? n : j_blk + BLOCK_SIZE;
+
+                for (int i = i_blk; i < i_max; i++) {
+                    for (int k = k_blk; k < k_max; k++) {
+                        __m256d a_vec = _mm256_set1_pd(A[i * n + k]);
+
+                        int j = j_blk;
+                        #ifdef __FMA__
+                        for (; j <= j_max - 8; j += 8) {
+                            __m256d c_vec1 = _mm256_load_pd(&C[i * n + j]);
+                            __m256d b_vec1 = _mm256_load_pd(&B[k * n + j]);
+                            c_vec1 = _mm256_fmadd_pd(a_vec, b_vec1, c_vec1);
+                            _mm256_store_pd(&C[i * n + j], c_vec1);
+
+                            __m256d c_vec2 = _mm256_load_pd(&C[i * n + j + 4]);
+                            __m256d b_vec2 = _mm256_load_pd(&B[k * n + j + 4]);
+                            c_vec2 = _mm256_fmadd_pd(a_vec, b_vec2, c_vec2);
+                            _mm256_store_pd(&C[i * n + j + 4], c_vec2);
+                        }
+                        #endif
+
+                        for (; j <= j_max - 4; j += 4) {
+                            __m256d c_vec = _mm256_load_pd(&C[i * n + j]);
+                            __m256d b_vec = _mm256_load_pd(&B[k * n + j]);
+                            #ifdef __FMA__
+                            c_vec = _mm256_fmadd_pd(a_vec, b_vec, c_vec);
+                            #else
+                            c_vec = _mm256_add_pd(c_vec, _mm256_mul_pd(a_vec, b_vec));
+                            #endif
+                            _mm256_store_pd(&C[i * n + j], c_vec);
+                        }
+
+                        for (; j < j_max; j++) {
+                            C[i * n + j] += A[i * n + k] * B[k * n + j];
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+void dgemm_avx_block(int n, double* A, double* B, double* C) {
+    dgemm_avx_block_rows(n, A, B, C, 0, n);
+}
+
+typedef struct {
+    int n;
+    double *A, *B, *C;
+} GemmJob;
+
+// Blocos de linhas distribuídos em round-robin entre as threads
+static void gemm_job(void* p, int tid, int nthreads) {
+    GemmJob* job = (GemmJob*)p;
+    for (int i_blk = tid * BLOCK_SIZE; i_blk < job->n; i_blk += nthreads * BLOCK_SIZE) {
+        int i_max = (i_blk + BLOCK_SIZE > job->n) ? job->n : i_blk + BLOCK_SIZE;
+        dgemm_avx_block_rows(job->n, job->A, job->B, job->C, i_blk, i_max);
+    }
+}
+
+void dgemm_avx_block_pool(ThreadPool* pool, int n, double* A, double* B, double* C) {
+    GemmJob job = {n, A, B, C};
+    pool_run(pool, gemm_job, &job);
+}
+
+// --- REFERÊNCIA: THREADS CRIADAS A CADA CHAMADA ---
+typedef struct {
+    GemmJob* job;
+    PoolFn fn;
+    int tid, nthreads;
+} SpawnArg;
+
+static void* spawn_entry(void* p) {
+    SpawnArg* sa = (SpawnArg*)p;
+    sa->fn(sa->job, sa->tid, sa->nthreads);
+    return NULL;
+}
+
+void run_spawn(int nthreads, PoolFn fn, GemmJob* job) {
+    pthread_t threads[MAX_THREADS];
+    SpawnArg args[MAX_THREADS];
+    int started[MAX_THREADS] = {0};
+    for (int t = 1; t < nthreads; t++) {
+        args[t] = (SpawnArg){job, fn, t, nthreads};
+        // Sem thread, a faixa roda aqui mesmo: nenhuma linha de C fica sem cálculo
+        if (pthread_create(&threads[t], NULL, spawn_entry, &args[t]) == 0) started[t] = 1;
+        else fn(job, t, nthreads);
+    }
+    fn(job, 0, nthreads);
+    for (int t = 1; t < nthreads; t++) {
+        if (started[t]) pthread_join(threads[t], NULL);
+    }
+}
+
+void dgemm_avx_block_spawn(int nthreads, int n, double* A, double* B, double* C) {
+    GemmJob job = {n, A, B, C};
+    run_spawn(nthreads, gemm_job, &job);
+}
+
+// ============================================================
+// --- BENCHMARKS ---
+// ============================================================
+static void empty_job(void* p, int tid, int nthreads) {
+    (void)p; (void)tid; (void)nthreads;
+}
+
+static void barrier_job(void* p, int tid, int nthreads) {
+    ThreadPool* pool = (ThreadPool*)p;
+    (void)nthreads;
+    for (int r = 0; r < BARRIER_ROUNDS; r++) pool_barrier(pool, tid);
+}
+
+// Média por chamada de despacho+join sem trabalho
+double measure_empty_pool(ThreadPool* pool) {
+    for (int w = 0; w < 100; w++) pool_run(pool, empty_job, NULL);
+    double start = get_time_sec();
+    for (int c = 0; c < EMPTY_CALLS; c++) pool_run(pool, empty_job, NULL);
+    return (get_time_sec() - start) / EMPTY_CALLS;
+}
+
+double measure_empty_spawn(int nthreads) {
+    int calls = EMPTY_CALLS / 20;
+    double start = get_time_sec();
+    for (int c = 0; c < calls; c++) run_spawn(nthreads, empty_job, NULL);
+    return (get_time_sec() - start) / calls;
+}
+
+// Repete a chamada até somar MIN_BENCH_SEC; devolve segundos por chamada
+typedef enum { MODO_SERIAL, MODO_POOL, MODO_SPAWN } Modo;
+
+double measure_gemm(Modo modo, ThreadPool* pool, int n, double* A, double* B, double* C, int* out_calls) {
+    clean_matrix(C, n);
+    int calls = 0;
+    double start = get_time_sec(), elapsed;
+    do {
+        if (modo == MODO_SERIAL) dgemm_avx_block(n, A, B, C);
+        else if (modo == MODO_POOL) dgemm_avx_block_pool(pool, n, A, B, C);
+        else dgemm_avx_block_spawn(pool->nthreads, n, A, B, C);
+        calls++;
+        elapsed = get_time_sec() - start;
+    } while (elapsed < MIN_BENCH_SEC);
+    *out_calls = calls;
+    return elapsed / calls;
+}
+
+double max_diff(const double* X, const double* Y, int n) {
+    double m = 0.0;
+    for (size_t i = 0; i < (size_t)n * n; i++) {
+        double d = X[i] - Y[i];
+        if (d < 0) d = -d;
+        if (d > m) m = d;
+    }
+    return m;
+}
+
+int main(int argc, char** argv) {
+    int ncpu = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    int nthreads = (argc > 1) ? atoi(argv[1]) : ncpu;
+    int sizes[] = {128, 192, 256, 384, 512};
+    int num_sizes = sizeof(sizes) / sizeof(sizes[0]);
+
+    static ThreadPool pool;
+    pool_init(&pool, nthreads);
+
+    printf("=== POOL PERSISTENTE: LATÊNCIA DE DESPACHO PARA GEMM PEQUENO ===\n");
+    printf("==========================================================\n");
+    printf("Threads: %d (núcleos online: %d)%s\n", pool.nthreads, ncpu,
+           pool.nthreads > ncpu ? "  [sobreinscrito: sem spin, workers dormem direto]" : "");
+    printf("Espera: %d voltas com pause, depois dorme na variável de condição\n\n", pool.spin_limit);
+
+    double t_empty_pool = measure_empty_pool(&pool);
+    double t_empty_spawn = measure_empty_spawn(pool.nthreads);
+
+    pool_run(&pool, barrier_job, &pool);   // Aquecimento
+    double start = get_time_sec();
+    pool_run(&pool, barrier_job, &pool);
+    double t_barrier = (get_time_sec() - start) / BARRIER_ROUNDS;
+
+    printf("Despacho + join vazio (pool):           %10.2f µs\n", t_empty_pool * 1e6);
+    printf("Despacho + join vazio (pthread_create): %10.2f µs\n", t_empty_spawn * 1e6);
+    printf("Barreira do pool:                       %10.2f µs\n\n", t_barrier * 1e6);
+
+    printf("+-------+---------+--------------+--------------+--------------+--------------+--------------+\n");
+    printf("|   N   | Chamadas| Serial (µs)  | Pool (µs)    | Spawn (µs)   | Overhead pool| Overhead spwn|\n");
+    printf("+-------+---------+--------------+--------------+--------------+--------------+--------------+\n");
+
+    for (int s = 0; s < num_sizes; s++) {
+        int n = sizes[s];
+        double* A = alloc_matrix(n, "Matriz A");
+        double* B = alloc_matrix(n, "Matriz B");
+        double* C = alloc_matrix(n, "Matriz C");
+        double* R = alloc_matrix(n, "Matriz Ref");
+
+        // Conferência do paralelo contra o serial
+        clean_matrix(R, n);
+        dgemm_avx_block(n, A, B, R);
+        clean_matrix(C, n);
+        dgemm_avx_block_pool(&pool, n, A, B, C);
+        if (max_diff(C, R, n) > 1e-9) {
+            printf("[ERRO] Resultado do pool diverge do serial em N=%d\n", n);
+            exit(1);
+        }
+
+        int calls_serial, calls_pool, calls_spawn;
+        double t_serial = measure_gemm(MODO_SERIAL, &pool, n, A, B, C, &calls_serial);
+        double t_pool = measure_gemm(MODO_POOL, &pool, n, A, B, C, &calls_pool);
+        double t_spawn = measure_gemm(MODO_SPAWN, &pool, n, A, B, C, &calls_spawn);
+
+        // Overhead = tempo da chamada paralela acima do ideal (serial / núcleos usados)
+        int cores = pool.nthreads < ncpu ? pool.nthreads : ncpu;
+        double ideal = t_serial / cores;
+        printf("| %5d | %7d | %12.1f | %12.1f | %12.1f | %12.1f | %12.1f |\n",
+               n, calls_pool, t_serial * 1e6, t_pool * 1e6, t_spawn * 1e6,
+               (t_pool - ideal) * 1e6, (t_spawn - ideal) * 1e6);
+
+        _mm_free(A); _mm_free(B); _mm_free(C); _mm_free(R);
+    }
+    printf("+-------+---------+--------------+--------------+--------------+--------------+--------------+\n");
+    printf("\nOverhead = tempo por chamada acima de Serial / min(threads, núcleos).\n");
+    printf("Inclui despacho, join e desbalanceamento entre blocos de linhas.\n");
+
+    pool_destroy(&pool);
+    return 0;
+}
@@ -0,0 +1,457 @@
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <string.h>
+#include <math.h>
+#include <immintrin.h>
+#include <x86intrin.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <pthread.h>
+
+// --- CONFIGURAÇÕES ---
+#define BLOCK_SIZE 32               // Block size otimizado para L1 Cache
+#define MAX_THREADS 64              // Limite de threads
+#define NUM_RUNS 3                  // Execuções para média estatística
+#define TRACE_RING_LOG2 18          // 2^18 eventos por thread (8 MB), sobrescreve os mais antigos
+#define TRACE_ARQUIVO "dgemm_trace.json"
+
+// --- UTILITÁRIOS DE TEMPO (Alta Precisão) ---
+double get_time_sec() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// --- ALOCAÇÃO E INICIALIZAÇÃO ---
+double* alloc_matrix(int n, const char* name) {
+    double* ptr = (double*)_mm_malloc((size_t)n * n * sizeof(double), 64);
+    if (!ptr) {
+        printf("[ERRO] Falha ao alocar %s\n", name);
+        exit(1);
+    }
+
+    for (size_t i = 0; i < (size_t)n * n; i++) {
+        ptr[i] = (double)((i % 100) + 1) * 0.01;
+    }
+    return ptr;
+}
+
+void clean_matrix(double* C, int n) {
+    memset(C, 0, (size_t)n * n * sizeof(double));
+}
+
+// ============================================================
+// --- RASTREAMENTO POR FASE (ativado com -DDGEMM_TRACE) ---
+// ============================================================
+// Cada thread grava eventos {início, fim, fase, tile} num anel próprio
+// (sem atomics nem locks: um escritor por anel). O relógio é o TSC lido com
+// rdtsc simples; a ordem exata de instruções não importa na escala de um
+// tile (microssegundos). Sem DGEMM_TRACE as macros viram nada e nenhuma
+// função de rastreamento é compilada.
+typedef enum { FASE_PACK, FASE_COMPUTE, FASE_EDGE, FASE_EPILOGUE, FASE_BARRIER, NUM_FASES } Fase;
+
+#ifdef DGEMM_TRACE
+
+static const char* nome_fase[NUM_FASES] = {"pack", "compute", "edge", "epilogue", "barrier"};
+
+typedef struct {
+    uint64_t t0, t1;        // Ticks do TSC
+    uint16_t fase;
+    uint16_t tid;
+    int16_t i, j, k;        // Índices do bloco (em blocos)
+} TraceEvent;
+
+typedef struct {
+    TraceEvent* ev;
+    uint64_t head;          // Total de eventos gravados (anel: head & máscara)
+    int tid;
+} TraceRing;
+
+static TraceRing trace_rings[MAX_THREADS];
+static __thread TraceRing* tls_ring;
+static double trace_ticks_per_us;
+static uint64_t trace_origin;
+
+#define TRACE_MASK ((1u << TRACE_RING_LOG2) - 1)
+
+static inline uint64_t trace_now(void) {
+    return __rdtsc();
+}
+
+void trace_thread_init(int tid) {
+    TraceRing* r = &trace_rings[tid];
+    if (!r->ev) {
+        r->ev = (TraceEvent*)malloc(sizeof(TraceEvent) << TRACE_RING_LOG2);
+        if (!r->ev) {
+            printf("[ERRO] Falha ao alocar anel de rastreamento\n");
+            exit(1);
+        }
+    }
+    r->tid = tid;
+    tls_ring = r;
+}
+
+static inline void trace_record(uint64_t t0, uint64_t t1, int fase, int i, int j, int k) {
+    TraceRing* r = tls_ring;
+    TraceEvent* e = &r->ev[r->head & TRACE_MASK];
+    e->t0 = t0;
+    e->t1 = t1;
+    e->fase = (uint16_t)fase;
+    e->tid = (uint16_t)r->tid;
+    e->i = (int16_t)i;
+    e->j = (int16_t)j;
+    e->k = (int16_t)k;
+    r->head++;
+}
+
+void trace_reset(void) {
+    for (int t = 0; t < MAX_THREADS; t++) trace_rings[t].head = 0;
+    trace_origin = trace_now();
+}
+
+// Ticks do TSC por microssegundo, medidos contra CLOCK_MONOTONIC
+void trace_calibrate(void) {
+    double s0 = get_time_sec();
+    uint64_t c0 = trace_now();
+    while (get_time_sec() - s0 < 0.05) { }
+    uint64_t c1 = trace_now();
+    double s1 = get_time_sec();
+    trace_ticks_per_us = (double)(c1 - c0) / ((s1 - s0) * 1e6);
+}
+
+#define TRACE_DECL(v)                       uint64_t v
+#define TRACE_START(v)                      ((v) = trace_now())
+#define TRACE_STOP(v, fase, i, j, k)        trace_record((v), trace_now(), (fase), (i), (j), (k))
+#define TRACE_THREAD_INIT(tid)              trace_thread_init(tid)
+
+#else
+
+#define TRACE_DECL(v)
+#define TRACE_START(v)                      ((void)0)
+#define TRACE_STOP(v, fase, i, j, k)        ((void)0)
+#define TRACE_THREAD_INIT(tid)              ((void)0)
+
+#endif
+
+// ============================================================
+// --- AVX + BLOCKING MULTITHREAD COM FASES EXPLÍCITAS ---
+// ============================================================
+// Mesma decomposição em blocos de dgemm_avx_block, com cada fase separada
+// para que o rastro diga onde o tempo vai:
+//   pack     - bloco de B (k_blk x j_blk) copiado para um buffer contíguo
+//   compute  - corpo FMA de 8 colunas sobre o acumulador do tile
+//   edge     - sobras de colunas (4 e escalar) quando a largura não é múltipla de 8
+//   epilogue - acumulador do tile somado em C
+//   barrier  - espera das threads no fim da chamada
+typedef struct {
+    int n;
+    double *A, *B, *C;
+    int tid, nthreads;
+    pthread_barrier_t* barrier;     // NULL: job rodado pelo principal no lugar de uma thread
+    pthread_mutex_t* gate;          // Segura as threads até a barreira ser criada
+} TraceJob;
+
+static void gemm_thread(TraceJob* job) {
+    int n = job->n;
+    const double* A = job->A;
+    const double* B = job->B;
+    double* C = job->C;
+    double acc[BLOCK_SIZE * BLOCK_SIZE] __attribute__((aligned(64)));
+    double bp[BLOCK_SIZE * BLOCK_SIZE] __attribute__((aligned(64)));
+    TRACE_DECL(t);
+
+    for (int i_blk = job->tid * BLOCK_SIZE; i_blk < n; i_blk += job->nthreads * BLOCK_SIZE) {
+        int i_max = (i_blk + BLOCK_SIZE > n) ? n : i_blk + BLOCK_SIZE;
+
+        for (int j_blk = 0; j_blk < n; j_blk += BLOCK_SIZE) {
+            int j_max = (j_blk + BLOCK_SIZE > n) ? n : j_blk + BLOCK_SIZE;
+            int jw = j_max - j_blk;
+            int jw8 = jw & ~7;
+            memset(acc, 0, sizeof(acc));
+
+            for (int k_blk = 0; k_blk < n; k_blk += BLOCK_SIZE) {
+                int k_max = (k_blk + BLOCK_SIZE > n) ? n : k_blk + BLOCK_SIZE;
+
+                TRACE_START(t);
+                for (int k = k_blk; k < k_max; k++) {
+                    memcpy(&bp[(k - k_blk) * BLOCK_SIZE], &B[(size_t)k * n + j_blk], jw * sizeof(double));
+                }
+                TRACE_STOP(t, FASE_PACK, i_blk / BLOCK_SIZE, j_blk / BLOCK_SIZE, k_blk / BLOCK_SIZE);
+
+                TRACE_START(t);
+                for (int i = i_blk; i < i_max; i++) {
+                    double* acc_row = &acc[(i - i_blk) * BLOCK_SIZE];
+                    for (int k = k_blk; k < k_max; k++) {
+                        __m256d a_vec = _mm256_set1_pd(A[(size_t)i * n + k]);
+                        const double* b_row = &bp[(k - k_blk) * BLOCK_SIZE];
+                        for (int j = 0; j < jw8; j += 8) {
+                            __m256d c_vec1 = _mm256_load_pd(&acc_row[j]);
+                            __m256d c_vec2 = _mm256_load_pd(&acc_row[j + 4]);
+                            #ifdef __FMA__
+                            c_vec1 = _mm256_fmadd_pd(a_vec, _mm256_load_pd(&b_row[j]), c_vec1);
+                            c_vec2 = _mm256_fmadd_pd(a_vec, _mm256_load_pd(&b_row[j + 4]), c_vec2);
+                            #else
+                            c_vec1 = _mm256_add_pd(c_vec1, _mm256_mul_pd(a_vec, _mm256_load_pd(&b_row[j])));
+                            c_vec2 = _mm256_add_pd(c_vec2, _mm256_mul_pd(a_vec, _mm256_load_pd(&b_row[j + 4])));
+                            #endif
+                            _mm256_store_pd(&acc_row[j], c_vec1);
+                            _mm256_store_pd(&acc_row[j + 4], c_vec2);
+                        }
+                    }
+                }
+                TRACE_STOP(t, FASE_COMPUTE, i_blk / BLOCK_SIZE, j_blk / BLOCK_SIZE, k_blk / BLOCK_SIZE);
+
+                if (jw8 < jw) {
+                    TRACE_START(t);
+                    for (int i = i_blk; i < i_max; i++) {
+                        double* acc_row = &acc[(i - i_blk) * BLOCK_SIZE];
+                        for (int k = k_blk; k < k_max; k++) {
+                            double a = A[(size_t)i * n + k];
+                            const double* b_row = &bp[(k - k_blk) * BLOCK_SIZE];
+                            int j = jw8;
+                            for (; j <= jw - 4; j += 4) {
+                                __m256d c_vec = _mm256_load_pd(&acc_row[j]);
+                                __m256d b_vec = _mm256_load_pd(&b_row[j]);
+                                c_vec = _mm256_add_pd(c_vec, _mm256_mul_pd(_mm256_set1_pd(a), b_vec));
+                                _mm256_store_pd(&acc_row[j], c_vec);
+                            }
+                            for (; j < jw; j++) acc_row[j] += a * b_row[j];
+                        }
+                    }
+                    TRACE_STOP(t, FASE_EDGE, i_blk / BLOCK_SIZE, j_blk / BLOCK_SIZE, k_blk / BLOCK_SIZE);
+                }
+            }
+
+            TRACE_START(t);
+            for (int i = i_blk; i < i_max; i++) {
+                double* c_row = &C[(size_t)i * n + j_blk];
+                const double* acc_row = &acc[(i - i_blk) * BLOCK_SIZE];
+                int j = 0;
+                for (; j <= jw - 4; j += 4) {
+                    _mm256_storeu_pd(&c_row[j], _mm256_add_pd(_mm256_loadu_pd(&c_row[j]), _mm256_load_pd(&acc_row[j])));
+                }
+                for (; j < jw; j++) c_row[j] += acc_row[j];
+            }
+            TRACE_STOP(t, FASE_EPILOGUE, i_blk / BLOCK_SIZE, j_blk / BLOCK_SIZE, -1);
+        }
+    }
+
+    if (job->barrier) {
+        TRACE_START(t);
+        pthread_barrier_wait(job->barrier);
+        TRACE_STOP(t, FASE_BARRIER, -1, -1, -1);
+    }
+}
+
+static void* gemm_thread_entry(void* p) {
+    TraceJob* job = (TraceJob*)p;
+    pthread_mutex_lock(job->gate);
+    pthread_mutex_unlock(job->gate);
+    TRACE_THREAD_INIT(job->tid);
+    gemm_thread(job);
+    return NULL;
+}
+
+void dgemm_avx_block_mt(int nthreads, int n, double* A, double* B, double* C) {
+    pthread_t threads[MAX_THREADS];
+    TraceJob jobs[MAX_THREADS];
+    int started[MAX_THREADS] = {0};
+    int nstarted = 1;   // Principal
+    pthread_barrier_t barrier;
+    pthread_mutex_t gate = PTHREAD_MUTEX_INITIALIZER;
+
+    // A barreira conta só as threads que subiram: enquanto o principal cria
+    // as threads, o gate fica fechado e nenhuma chega na barreira
+    pthread_mutex_lock(&gate);
+    for (int t = 0; t < nthreads; t++) {
+        jobs[t] = (TraceJob){n, A, B, C, t, nthreads, &barrier, &gate};
+        if (t > 0 && pthread_create(&threads[t], NULL, gemm_thread_entry, &jobs[t]) == 0) {
+            started[t] = 1;
+            nstarted++;
+        }
+    }
+    pthread_barrier_init(&barrier, NULL, nstarted);
+    pthread_mutex_unlock(&gate);
+
+    // Tiles de thread que não subiu rodam aqui, fora da barreira
+    for (int t = 1; t < nthreads; t++) {
+        if (!started[t]) {
+            jobs[t].barrier = NULL;
+            gemm_thread_entry(&jobs[t]);
+        }
+    }
+    gemm_thread_entry(&jobs[0]);
+    for (int t = 1; t < nthreads; t++) {
+        if (started[t]) pthread_join(threads[t], NULL);
+    }
+    pthread_barrier_destroy(&barrier);
+    pthread_mutex_destroy(&gate);
+}
+
+// ============================================================
+// --- EXPORTAÇÃO E RESUMO ---
+// ============================================================
+#ifdef DGEMM_TRACE
+
+// Eventos ainda no anel da thread t: [first, head)
+static uint64_t ring_first(const TraceRing* r) {
+    uint64_t cap = (uint64_t)1 << TRACE_RING_LOG2;
+    return (r->head > cap) ? r->head - cap : 0;
+}
+
+// Formato Chrome/Perfetto: eventos completos ("ph":"X") com ts/dur em µs
+int trace_export_chrome(const char* path, int nthreads) {
+    FILE* fp = fopen(path, "w");
+    if (!fp) {
+        printf("[ERRO] Não foi possível criar %s\n", path);
+        return 0;
+    }
+    fprintf(fp, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    int first = 1;
+    for (int t = 0; t < nthreads; t++) {
+        fprintf(fp, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"worker %d\"}}",
+                first ? "" : ",\n", t, t);
+        first = 0;
+    }
+    for (int t = 0; t < nthreads; t++) {
+        const TraceRing* r = &trace_rings[t];
+        for (uint64_t e = ring_first(r); e < r->head; e++) {
+            const TraceEvent* ev = &r->ev[e & TRACE_MASK];
+            double ts = (double)(ev->t0 - trace_origin) / trace_ticks_per_us;
+            double dur = (double)(ev->t1 - ev->t0) / trace_ticks_per_us;
+            fprintf(fp, ",\n{\"name\":\"%s\",\"cat\":\"dgemm\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,"
+                        "\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"i\":%d,\"j\":%d,\"k\":%d}}",
+                    nome_fase[ev->fase], ev->tid, ts, dur, ev->i, ev->j, ev->k);
+        }
+    }
+    fprintf(fp, "\n]}\n");
+    fclose(fp);
+    return 1;
+}
+
+void trace_summary(int nthreads) {
+    double total[NUM_FASES] = {0};
+    uint64_t count[NUM_FASES] = {0};
+    uint64_t gravados = 0, perdidos = 0;
+
+    for (int t = 0; t < nthreads; t++) {
+        const TraceRing* r = &trace_rings[t];
+        uint64_t first = ring_first(r);
+        gravados += r->head;
+        perdidos += first;
+        for (uint64_t e = first; e < r->head; e++) {
+            const TraceEvent* ev = &r->ev[e & TRACE_MASK];
+            total[ev->fase] += (double)(ev->t1 - ev->t0) / trace_ticks_per_us;
+            count[ev->fase]++;
+        }
+    }
+    double soma = 0.0;
+    for (int f = 0; f < NUM_FASES; f++) soma += total[f];
+
+    printf("\n+-----------+-----------+--------------+--------------+---------+\n");
+    printf("| Fase      | Eventos   | Total (ms)   | Médio (µs)   | %% tempo |\n");
+    printf("+-----------+-----------+--------------+--------------+---------+\n");
+    for (int f = 0; f < NUM_FASES; f++) {
+        printf("| %-9s | %9lu | %12.3f | %12.3f | %6.1f%% |\n", nome_fase[f], (unsigned long)count[f],
+               total[f] * 1e-3, count[f] ? total[f] / count[f] : 0.0, soma > 0 ? total[f] / soma * 100 : 0.0);
+    }
+    printf("+-----------+-----------+--------------+--------------+---------+\n");
+    printf("Eventos gravados: %lu | sobrescritos no anel: %lu\n", (unsigned long)gravados, (unsigned long)perdidos);
+}
+
+// Custo de um par TRACE_START/TRACE_STOP (anel de uma thread descartável)
+double trace_cost_ns(void) {
+    const int reps = 1000000;
+    TraceRing* saved = tls_ring;
+    TraceRing tmp = {NULL, 0, 0};
+    tmp.ev = (TraceEvent*)malloc(sizeof(TraceEvent) << TRACE_RING_LOG2);
+    if (!tmp.ev) {
+        printf("[ERRO] Falha ao alocar anel de rastreamento\n");
+        exit(1);
+    }
+    tls_ring = &tmp;
+    TRACE_DECL(t);
+    double start = get_time_sec();
+    for (int r = 0; r < reps; r++) {
+        TRACE_START(t);
+        TRACE_STOP(t, FASE_COMPUTE, 0, 0, r & 0x7fff);
+    }
+    double elapsed = get_time_sec() - start;
+    free(tmp.ev);
+    tls_ring = saved;
+    return elapsed / reps * 1e9;
+}
+
+#endif
+
+// Confere uma amostra de C contra o produto escalar direto
+double check_sample(int n, const double* A, const double* B, const double* C) {
+    double max_err = 0.0;
+    for (int s = 0; s < 64; s++) {
+        int i = (s * 7919) % n, j = (s * 104729 + 13) % n;
+        double ref = 0.0;
+        for (int k = 0; k < n; k++) ref += A[(size_t)i * n + k] * B[(size_t)k * n + j];
+        double err = fabs(C[(size_t)i * n + j] - ref) / (fabs(ref) > 1.0 ? fabs(ref) : 1.0);
+        if (err > max_err) max_err = err;
+    }
+    return max_err;
+}
+
+int main(int argc, char** argv) {
+    int n = (argc > 1) ? atoi(argv[1]) : 1007;     // Sobra de 15 colunas: 8 + 4 + 3
+    int nthreads = (argc > 2) ? atoi(argv[2]) : (int)sysconf(_SC_NPROCESSORS_ONLN);
+    const char* arquivo = (argc > 3) ? argv[3] : TRACE_ARQUIVO;
+    if (nthreads < 1) nthreads = 1;
+    if (nthreads > MAX_THREADS) nthreads = MAX_THREADS;
+
+    printf("=== RASTREAMENTO POR FASE DO AVX+BLOCKING ===\n");
+    printf("==========================================================\n");
+    printf("Matriz: %d x %d | threads: %d | bloco: %d (sobra de %d colunas no último bloco)\n",
+           n, n, nthreads, BLOCK_SIZE, n % BLOCK_SIZE);
+    #ifdef DGEMM_TRACE
+    trace_calibrate();
+    printf("Rastreamento: ATIVO | TSC: %.1f ticks/µs | anel: %d eventos/thread\n",
+           trace_ticks_per_us, 1 << TRACE_RING_LOG2);
+    #else
+    printf("Rastreamento: DESATIVADO (compile com -DDGEMM_TRACE para gravar as fases)\n");
+    #endif
+
+    double* A = alloc_matrix(n, "Matriz A");
+    double* B = alloc_matrix(n, "Matriz B");
+    double* C = alloc_matrix(n, "Matriz C");
+
+    clean_matrix(C, n);
+    dgemm_avx_block_mt(nthreads, n, A, B, C);   // Aquecimento
+
+    double total = 0.0;
+    for (int r = 0; r < NUM_RUNS; r++) {
+        clean_matrix(C, n);
+        #ifdef DGEMM_TRACE
+        trace_reset();      // O rastro exportado é o da última execução
+        #endif
+        double start = get_time_sec();
+        dgemm_avx_block_mt(nthreads, n, A, B, C);
+        total += get_time_sec() - start;
+    }
+    double avg = total / NUM_RUNS;
+    double gflops = 2.0 * (double)n * n * n / avg * 1e-9;
+    printf("\nTempo médio: %.4f s | %.2f GFLOPS | erro (amostra): %.1e\n", avg, gflops, check_sample(n, A, B, C));
+
+    #ifdef DGEMM_TRACE
+    trace_summary(nthreads);
+    printf("Custo de um par início/fim: %.1f ns\n", trace_cost_ns());
+    if (trace_export_chrome(arquivo, nthreads)) {
+        printf("Rastro salvo em %s (abrir em chrome://tracing ou ui.perfetto.dev)\n", arquivo);
+    }
+    #else
+    (void)arquivo;
+    printf("Compare com o binário -DDGEMM_TRACE: a diferença de GFLOPS é o custo do rastreamento.\n");
+    #endif
+
+    _mm_free(A);
+    _mm_free(B);
+    _mm_free(C);
+    return 0;
+}
@@ -1,28 +1,28 @@
 // pipeline_ctrl.v
 module pipeline_ctrl(
     input stall,           // Do hazard_unit
-    input branch_taken,    // Do estágio EX (branch foi tomado?)
-    input jal_taken,       // Do estágio EX (jal foi executado?)
-    input jalr_taken,      // Do estágio EX (jalr foi executado?)
-    
+    input mispredict,      // Do branch_check (estágio EX): próximo PC previsto errado
+
     // Sinais de controle para o pipeline
     output reg pc_write,     // Para PC: 1=atualiza, 0=congela
+    output reg pc_recover,   // Para next_pc: 1=usa correct_pc do EX
     output reg if_id_write,  // Para IF/ID: 1=atualiza, 0=congela
     output reg if_id_flush,  // Para IF/ID: 1=insere NOP (flush)
     output reg id_ex_flush   // Para ID/EX: 1=insere NOP (flush)
 );
 
-    // Sinal combinado para jumps/branches
-    wire jump_taken;
-    assign jump_taken = branch_taken | jal_taken | jalr_taken;
-    
+    // Com o branch_predictor a busca já segue o alvo previsto; só há flush
+    // quando a predição feita em IF não bate com o resultado de EX
+    // (desvio, jal ou jalr). Desvio tomado e previsto não custa nada.
+
     always @(*) begin
         // Valores padrão: tudo normal, pipeline fluindo
         pc_write = 1'b1;
+        pc_recover = 1'b0;
         if_id_write = 1'b1;
         if_id_flush = 1'b0;
         id_ex_flush = 1'b0;
-        
+
         // CASO 1: Stall (Load-Use Hazard)
         if (stall) begin
             // Congela o pipeline
@@ -30,15 +30,16 @@ module pipeline_ctrl(
             if_id_write = 1'b0;   // IF/ID não atualiza
             id_ex_flush = 1'b1;   // Insere NOP em ID/EX (bolha)
         end
-        
-        // CASO 2: Jump/Branch taken
-        else if (jump_taken) begin
+
+        // CASO 2: Predição errada
+        else if (mispredict) begin
             // Descartar instruções erradas no pipeline
+            pc_recover = 1'b1;    // Busca volta para o PC correto
             if_id_flush = 1'b1;   // Descarta instrução em IF/ID
             id_ex_flush = 1'b1;   // Descarta instrução em ID/EX
         end
-        
-        // Se não stall nem jump, mantém valores padrão
+
+        // Se não stall nem predição errada, mantém valores padrão
     end
-    
+
 endmodule
\ No newline at end of file
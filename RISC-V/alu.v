@@ -1,6 +1,7 @@
 module alu(
     input [31:0] a,
     input [31:0] b,
+    input [31:0] c,        // Acumulador (valor de rd) para vdot
     input [5:0] alu_ctrl,  // [5:4]=modo, [3:0]=operação
     output reg [31:0] result,
     output zero
@@ -9,6 +10,8 @@ module alu(
     wire [3:0] op = alu_ctrl[3:0];
     reg [7:0] b0,b1,b2,b3;
     reg [15:0] h0,h1;
+    reg [15:0] p0,p1,p2,p3;  // Produtos 8x8 com sinal
+    reg [31:0] q0,q1;        // Produtos 16x16 com sinal
     
     always @(*) begin
         case (vec_mode)
@@ -45,6 +48,21 @@ module alu(
                     end
                     4'b0010: result = a & b; // vand.8
                     4'b0011: result = a | b; // vor.8
+                    4'b0100: begin // vmul.8 (8 bits baixos de cada produto)
+                        b0 = a[7:0] * b[7:0];
+                        b1 = a[15:8] * b[15:8];
+                        b2 = a[23:16] * b[23:16];
+                        b3 = a[31:24] * b[31:24];
+                        result = {b3, b2, b1, b0};
+                    end
+                    4'b0101: begin // vdot.8: rd + soma de 4 produtos 8x8 com sinal
+                        p0 = $signed(a[7:0]) * $signed(b[7:0]);
+                        p1 = $signed(a[15:8]) * $signed(b[15:8]);
+                        p2 = $signed(a[23:16]) * $signed(b[23:16]);
+                        p3 = $signed(a[31:24]) * $signed(b[31:24]);
+                        result = c + {{16{p0[15]}}, p0} + {{16{p1[15]}}, p1}
+                                   + {{16{p2[15]}}, p2} + {{16{p3[15]}}, p3};
+                    end
                     default: result = 0;
                 endcase
             end
@@ -63,6 +81,16 @@ module alu(
                     end
                     4'b0010: result = a & b; // vand.16
                     4'b0011: result = a | b; // vor.16
+                    4'b0100: begin // vmul.16 (16 bits baixos de cada produto)
+                        h0 = a[15:0] * b[15:0];
+                        h1 = a[31:16] * b[31:16];
+                        result = {h1, h0};
+                    end
+                    4'b0101: begin // vdot.16: rd + soma de 2 produtos 16x16 com sinal
+                        q0 = $signed(a[15:0]) * $signed(b[15:0]);
+                        q1 = $signed(a[31:16]) * $signed(b[31:16]);
+                        result = c + q0 + q1;
+                    end
                     default: result = 0;
                 endcase
             end
@@ -8,15 +8,21 @@ module alu_control(
     always @(*) begin
         if (is_vector) begin
             // Modo vetorial: [5:4]=modo, [3:0]=operação
-            case (funct3)
-                3'b000: alu_ctrl = 6'b01_0000; // vadd.8
-                3'b001: alu_ctrl = 6'b10_0000; // vadd.16
-                3'b010: alu_ctrl = 6'b01_0001; // vsub.8
-                3'b011: alu_ctrl = 6'b10_0001; // vsub.16
-                3'b100: alu_ctrl = 6'b01_0010; // vand.8
-                3'b101: alu_ctrl = 6'b10_0010; // vand.16
-                3'b110: alu_ctrl = 6'b01_0011; // vor.8
-                3'b111: alu_ctrl = 6'b10_0011; // vor.16
+            // funct7 = 0000000: add/sub/and/or; funct7 = 0000001: mul/dot
+            // (funct7 inteiro, como reads_rd no control_unit; outro valor é inválido)
+            case ({funct7, funct3})
+                10'b0000000_000: alu_ctrl = 6'b01_0000; // vadd.8
+                10'b0000000_001: alu_ctrl = 6'b10_0000; // vadd.16
+                10'b0000000_010: alu_ctrl = 6'b01_0001; // vsub.8
+                10'b0000000_011: alu_ctrl = 6'b10_0001; // vsub.16
+                10'b0000000_100: alu_ctrl = 6'b01_0010; // vand.8
+                10'b0000000_101: alu_ctrl = 6'b10_0010; // vand.16
+                10'b0000000_110: alu_ctrl = 6'b01_0011; // vor.8
+                10'b0000000_111: alu_ctrl = 6'b10_0011; // vor.16
+                10'b0000001_000: alu_ctrl = 6'b01_0100; // vmul.8
+                10'b0000001_001: alu_ctrl = 6'b10_0100; // vmul.16
+                10'b0000001_010: alu_ctrl = 6'b01_0101; // vdot.8  (4x8 -> 32, acumula em rd)
+                10'b0000001_011: alu_ctrl = 6'b10_0101; // vdot.16 (2x16 -> 32, acumula em rd)
                 default: alu_ctrl = 6'b00_0000;
             endcase
         end else begin
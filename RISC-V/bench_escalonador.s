@@ -0,0 +1,42 @@
+# bench_escalonador.s - código "escrito à mão", com o uso logo depois do load
+# ./montador bench_escalonador.s -n -o /tmp/sem.hex && ./simulador /tmp/sem.hex -r
+# ./montador bench_escalonador.s && ./simulador bench_escalonador.hex -r
+# Esperado: x10 = 130560 (soma de A), x11 = -128 (vdot.8 de A com 1s, bytes com sinal), x12 = 101 (busca)
+
+# A[i] = 4*i em 0x000, B[i] = 0x01010101 em 0x400 (256 palavras cada)
+        addi x1, x0, 0
+        addi x2, x0, 1
+        slli x2, x2, 10         # 1024 (addi 1024 tem o bit 30 ligado: alu_control.v faria SUB)
+        li x3, 0x01010101
+init:   sw x1, 0(x1)
+        sw x3, 1024(x1)
+        addi x1, x1, 4
+        bne x1, x2, init
+
+# Soma escalar, desenrolada 2x
+        addi x1, x0, 0
+        addi x10, x0, 0
+soma:   lw x5, 0(x1)
+        add x10, x10, x5
+        lw x6, 4(x1)
+        add x10, x10, x6
+        addi x1, x1, 8
+        bne x1, x2, soma
+
+# Produto escalar int8 com vdot.8
+        addi x1, x0, 0
+        addi x11, x0, 0
+dot:    lw x5, 0(x1)
+        lw x6, 1024(x1)
+        vdot.8 x11, x5, x6
+        addi x1, x1, 4
+        bne x1, x2, dot
+
+# Busca do primeiro A[i] >= 400 (load logo antes do desvio)
+        addi x12, x0, 0
+        addi x7, x0, 400
+busca:  slli x8, x12, 2
+        addi x12, x12, 1
+        lw x5, 0(x8)
+        blt x5, x7, busca
+        ecall
@@ -0,0 +1,122 @@
+// branch_predictor.v - BTB + contadores de 2 bits (bimodal ou gshare)
+// Consulta em IF com o PC atual; atualização em EX com o resultado real.
+// Só prevê "tomado" quando a BTB conhece o alvo: jal/jalr sempre tomados,
+// desvios condicionais pelo bit alto do contador.
+module branch_predictor #(
+    parameter BTB_BITS = 6,   // 64 entradas na BTB
+    parameter PHT_BITS = 8,   // 256 contadores / histórico global de 8 bits
+    parameter GSHARE = 1      // 1 = índice pc ^ histórico, 0 = bimodal (só pc)
+)(
+    input clk,
+    input reset,
+
+    // Consulta (IF)
+    input [31:0] if_pc,
+    output pred_taken,
+    output [31:0] pred_target,
+    output [PHT_BITS-1:0] pred_idx,     // Vai junto com a instrução até EX
+
+    // Atualização (EX)
+    input ex_branch,                    // Desvio condicional em EX
+    input ex_jump,                      // jal/jalr em EX
+    input ex_taken,                     // Resultado real
+    input [31:0] ex_pc,
+    input [31:0] ex_target,
+    input [PHT_BITS-1:0] ex_pred_idx    // Índice usado na consulta
+);
+    localparam BTB_N = 1 << BTB_BITS;
+    localparam PHT_N = 1 << PHT_BITS;
+    localparam TAG_W = 30 - BTB_BITS;
+
+    // BTB
+    reg btb_valid [0:BTB_N-1];
+    reg btb_jump [0:BTB_N-1];
+    reg [TAG_W-1:0] btb_tag [0:BTB_N-1];
+    reg [31:0] btb_target [0:BTB_N-1];
+
+    // Tabela de contadores de 2 bits e histórico global
+    reg [1:0] pht [0:PHT_N-1];
+    reg [PHT_BITS-1:0] ghr;
+
+    // --- Consulta (combinacional) ---
+    wire [BTB_BITS-1:0] if_btb_idx = if_pc[BTB_BITS+1:2];
+    wire btb_hit = btb_valid[if_btb_idx] && (btb_tag[if_btb_idx] == if_pc[31:BTB_BITS+2]);
+
+    assign pred_idx = GSHARE ? (if_pc[PHT_BITS+1:2] ^ ghr) : if_pc[PHT_BITS+1:2];
+    assign pred_taken = btb_hit && (btb_jump[if_btb_idx] || pht[pred_idx][1]);
+    assign pred_target = btb_target[if_btb_idx];
+
+    // --- Atualização (na borda, com o resultado de EX) ---
+    wire [BTB_BITS-1:0] ex_btb_idx = ex_pc[BTB_BITS+1:2];
+    integer i;
+
+    always @(posedge clk or posedge reset) begin
+        if (reset) begin
+            for (i = 0; i < BTB_N; i = i + 1) begin
+                btb_valid[i] <= 0; btb_jump[i] <= 0;
+                btb_tag[i] <= 0; btb_target[i] <= 0;
+            end
+            for (i = 0; i < PHT_N; i = i + 1) pht[i] <= 2'b01; // Fracamente não tomado
+            ghr <= 0;
+        end else begin
+            if (ex_branch) begin
+                if (ex_taken && pht[ex_pred_idx] != 2'b11)
+                    pht[ex_pred_idx] <= pht[ex_pred_idx] + 1;
+                else if (!ex_taken && pht[ex_pred_idx] != 2'b00)
+                    pht[ex_pred_idx] <= pht[ex_pred_idx] - 1;
+                ghr <= {ghr[PHT_BITS-2:0], ex_taken};
+            end
+            // Só desvios tomados entram na BTB
+            if ((ex_branch || ex_jump) && ex_taken) begin
+                btb_valid[ex_btb_idx] <= 1;
+                btb_jump[ex_btb_idx] <= ex_jump;
+                btb_tag[ex_btb_idx] <= ex_pc[31:BTB_BITS+2];
+                btb_target[ex_btb_idx] <= ex_target;
+            end
+        end
+    end
+endmodule
+
+
+// branch_check - Resolve o desvio em EX e compara com a predição de IF
+// Os operandos a/b já vêm do forwarding. Uma bolha chega com tudo em zero e
+// pred_taken = 0, então nunca gera mispredict.
+module branch_check(
+    input branch,              // Desvio condicional
+    input jal,
+    input jalr,
+    input [2:0] funct3,
+    input [31:0] a,
+    input [31:0] b,
+    input [31:0] pc,
+    input [31:0] imm,
+    input pred_taken,          // Predição carregada por IF/ID e ID/EX
+    input [31:0] pred_target,
+    output reg taken,          // Resultado real
+    output [31:0] target,      // Alvo real
+    output [31:0] correct_pc,  // Para onde a busca deve voltar
+    output mispredict          // Para pipeline_ctrl
+);
+    always @(*) begin
+        taken = 1'b0;
+        if (jal || jalr) taken = 1'b1;
+        else if (branch) begin
+            case (funct3)
+                3'b000: taken = (a == b);                    // beq
+                3'b001: taken = (a != b);                    // bne
+                3'b100: taken = ($signed(a) < $signed(b));   // blt
+                3'b101: taken = ($signed(a) >= $signed(b));  // bge
+                3'b110: taken = (a < b);                     // bltu
+                3'b111: taken = (a >= b);                    // bgeu
+                default: taken = 1'b0;
+            endcase
+        end
+    end
+
+    assign target = jalr ? ((a + imm) & ~32'd1) : (pc + imm);
+    assign correct_pc = taken ? target : pc + 4;
+
+    // Próximo PC previsto diferente do real
+    wire [31:0] predicted_pc = pred_taken ? pred_target : pc + 4;
+    assign mispredict = (predicted_pc != correct_pc);
+endmodule
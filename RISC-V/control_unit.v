@@ -1,5 +1,7 @@
 module control(
     input [6:0] opcode,
+    input [2:0] funct3,
+    input [6:0] funct7,
     output reg reg_write,
     output reg mem_to_reg,
     output reg mem_read,
@@ -7,12 +9,20 @@ module control(
     output reg alu_src,
     output reg [1:0] alu_op,
     output reg branch,
-    output reg is_vector
+    output reg is_vector,
+    output reg reads_rd,   // vdot: rd também é fonte (acumulador)
+    // Segunda porta de escrita (lw.pi, sw.pi, ld.par)
+    output reg reg_write2,
+    output reg mem_to_reg2,  // 1 = palavra alta da memória, 0 = alu_result
+    output reg rd2_sel,      // 0 = rd2 é rs1 (base), 1 = rd2 é rd+1 (par)
+    output reg post_inc,     // Endereço de memória = rs1; a ALU faz rs1 + imm
+    output reg mem_pair      // Leitura de 64 bits
 );
     always @(*) begin
         reg_write = 0; mem_to_reg = 0; mem_read = 0;
         mem_write = 0; alu_src = 0; alu_op = 0; 
-        branch = 0; is_vector = 0;
+        branch = 0; is_vector = 0; reads_rd = 0;
+        reg_write2 = 0; mem_to_reg2 = 0; rd2_sel = 0; post_inc = 0; mem_pair = 0;
         
         case (opcode)
             7'b0110011: begin reg_write = 1; alu_op = 2'b10; end // R-type
@@ -21,7 +31,23 @@ module control(
             7'b0100011: begin mem_write = 1; alu_src = 1; end // SW
             7'b1100011: begin branch = 1; alu_op = 2'b01; end // Branch
             7'b0110111: begin reg_write = 1; alu_src = 1; alu_op = 2'b11; end // LUI
-            7'b0100111: begin reg_write = 1; is_vector = 1; alu_op = 2'b11; end // Vetorial
+            7'b0100111: begin // Vetorial
+                reg_write = 1; is_vector = 1; alu_op = 2'b11;
+                reads_rd = (funct7 == 7'b0000001) && (funct3[2:1] == 2'b01); // vdot.8/vdot.16
+            end
+            7'b0001011: begin // custom-0: lw.pi (funct3=010), ld.par (funct3=011)
+                reg_write = 1; mem_read = 1; mem_to_reg = 1; alu_src = 1;
+                reg_write2 = 1;
+                if (funct3 == 3'b011) begin
+                    mem_pair = 1; mem_to_reg2 = 1; rd2_sel = 1; // rd+1 = M[addr+4]
+                end else begin
+                    post_inc = 1;                              // rs1 = rs1 + imm
+                end
+            end
+            7'b0101011: begin // custom-1: sw.pi
+                mem_write = 1; alu_src = 1;
+                reg_write2 = 1; post_inc = 1;                  // rs1 = rs1 + imm
+            end
             default: ; // NOP
         endcase
     end
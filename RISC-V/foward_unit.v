@@ -1,29 +1,47 @@
 module forwarding_unit(
     input [4:0] ex_rs1,
     input [4:0] ex_rs2,
+    input [4:0] ex_rd,       // Acumulador do vdot (rd lido como fonte)
+    input ex_reads_rd,
     input mem_reg_write,
     input [4:0] mem_rd,
+    input mem_reg_write2,    // Porta 2: base do pós-incremento / palavra alta do ld.par
+    input [4:0] mem_rd2,
     input wb_reg_write,
     input [4:0] wb_rd,
+    input wb_reg_write2,
+    input [4:0] wb_rd2,
     output reg [1:0] forwardA,
-    output reg [1:0] forwardB
+    output reg [1:0] forwardB,
+    output reg [1:0] forwardC
 );
+    // Códigos: 00 = banco, 10 = EX/MEM alu_result, 01 = MEM/WB porta 1,
+    // 11 = MEM/WB porta 2. De EX/MEM só sai alu_result: na porta 2 isso é a
+    // base atualizada (lw.pi/sw.pi); a palavra alta do ld.par em MEM ainda não
+    // existe e é coberta pelo stall do hazard_unit.
+    // Prioridade: MEM > WB; dentro de WB, porta 1 > porta 2 (como no regfile)
+    function [1:0] seleciona;
+        input [4:0] r;
+        begin
+            if (r != 0 && ((mem_reg_write && mem_rd == r) || (mem_reg_write2 && mem_rd2 == r)))
+                seleciona = 2'b10;
+            else if (r != 0 && wb_reg_write && wb_rd == r)
+                seleciona = 2'b01;
+            else if (r != 0 && wb_reg_write2 && wb_rd2 == r)
+                seleciona = 2'b11;
+            else
+                seleciona = 2'b00;
+        end
+    endfunction
+
     always @(*) begin
-        forwardA = 2'b00;
-        forwardB = 2'b00;
-        
         // Forward A
-        if (mem_reg_write && mem_rd != 0 && mem_rd == ex_rs1) begin
-            forwardA = 2'b10;
-        end else if (wb_reg_write && wb_rd != 0 && wb_rd == ex_rs1) begin
-            forwardA = 2'b01;
-        end
+        forwardA = seleciona(ex_rs1);
         
         // Forward B
-        if (mem_reg_write && mem_rd != 0 && mem_rd == ex_rs2) begin
-            forwardB = 2'b10;
-        end else if (wb_reg_write && wb_rd != 0 && wb_rd == ex_rs2) begin
-            forwardB = 2'b01;
-        end
+        forwardB = seleciona(ex_rs2);
+        
+        // Forward C (acumulador)
+        forwardC = ex_reads_rd ? seleciona(ex_rd) : 2'b00;
     end
-endmodule
\ No newline at end of file
+endmodule
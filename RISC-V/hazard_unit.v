@@ -1,16 +1,26 @@
 module hazard_unit(
     input [4:0] id_rs1,
     input [4:0] id_rs2,
+    input [4:0] id_rd,       // Fonte extra do vdot (acumulador)
+    input id_reads_rd,
     input ex_mem_read,
     input [4:0] ex_rd,
+    input ex_mem_to_reg2,    // ld.par: rd+1 também vem da memória
+    input [4:0] ex_rd2,
     output reg stall
 );
     always @(*) begin
         stall = 0;
         if (ex_mem_read && ex_rd != 0) begin
-            if (ex_rd == id_rs1 || ex_rd == id_rs2) begin
+            if (ex_rd == id_rs1 || ex_rd == id_rs2 || (id_reads_rd && ex_rd == id_rd)) begin
+                stall = 1;
+            end
+        end
+        // Palavra alta do ld.par (a base do lw.pi sai da ALU e vai por forwarding)
+        if (ex_mem_read && ex_mem_to_reg2 && ex_rd2 != 0) begin
+            if (ex_rd2 == id_rs1 || ex_rd2 == id_rs2 || (id_reads_rd && ex_rd2 == id_rd)) begin
                 stall = 1;
             end
         end
     end
-endmodule
\ No newline at end of file
+endmodule
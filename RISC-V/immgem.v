@@ -5,12 +5,12 @@ module imm_gen(
 
     always @(*) begin
         case (instr[6:0])  // Baseado no opcode
-            // I-type (addi, lw, jalr)
-            7'b0010011, 7'b0000011, 7'b1100111: 
+            // I-type (addi, lw, jalr, lw.pi, ld.par)
+            7'b0010011, 7'b0000011, 7'b1100111, 7'b0001011: 
                 imm = {{20{instr[31]}}, instr[31:20]};
             
-            // S-type (sw)
-            7'b0100011: 
+            // S-type (sw, sw.pi)
+            7'b0100011, 7'b0101011: 
                 imm = {{20{instr[31]}}, instr[31:25], instr[11:7]};
             
             // B-type (beq, bne)
@@ -0,0 +1,726 @@
+// montador.cpp - Montador RV32I + extensão vetorial com escalonamento de hazards
+//
+// Gera o .hex da ROM (uma instrução por linha, comentário com o assembly, o
+// mesmo formato de exemplo.hex) a partir de um .s. Antes de gerar, um passo
+// de list scheduling reordena instruções independentes dentro de cada bloco
+// básico para tirar as bolhas de load-use, usando as mesmas regras do
+// hazard_unit.v / foward_unit.v (as mesmas do simulador.cpp):
+//   - só há stall quando a instrução imediatamente seguinte a um load tem o
+//     rd do load num dos campos rs1/rs2 crus (ou no rd, se for vdot); com
+//     uma instrução no meio o forwarding MEM/WB resolve
+//   - os demais resultados vão por forwarding EX/MEM sem custo
+//   - ld.par também conta o rd+1 (palavra alta vinda da memória)
+// O desvio é resolvido em EX e não tem delay slot: a única bolha "de desvio"
+// que a ordem das instruções elimina é a de um load logo antes do desvio que
+// compara o valor carregado. Essa é a vaga que o escalonador tenta preencher.
+//
+// Blocos básicos: começam num rótulo ou depois de desvio/jal/jalr/ecall;
+// o terminador fica no fim. auipc depende do próprio PC e não se move.
+// Dependências: RAW/WAR/WAW nos registradores realmente lidos/escritos
+// (inclusive a segunda porta de lw.pi/sw.pi/ld.par) e ordem entre acessos
+// à memória, exceto loads entre si e acessos com a mesma base (sem escrita
+// no meio) em faixas disjuntas.
+// A ordem nova só é aceita se tirar stalls sem criar leitura WB->ID (dist. 3)
+// a mais que a original: o regfile.v lê o valor antigo nesse caso.
+//
+// Sintaxe: uma instrução por linha, "rotulo:" opcional, comentários '#' ou '//'.
+// Registradores x0..x31 ou nomes da ABI. Pseudo: nop, mv, li, j, jr, ret, beqz, bnez.
+//
+// Compilação: g++ -O2 -std=c++17 -o montador montador.cpp
+// Uso:        ./montador programa.s [-o programa.hex] [-n] [-v] [-b]
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+// --- OPCODES (os mesmos do simulador.cpp) ---
+enum Opcode : uint8_t {
+    OP_R      = 0x33,  // 0110011
+    OP_I      = 0x13,  // 0010011
+    OP_LOAD   = 0x03,  // 0000011
+    OP_STORE  = 0x23,  // 0100011
+    OP_BRANCH = 0x63,  // 1100011
+    OP_LUI    = 0x37,  // 0110111
+    OP_AUIPC  = 0x17,  // 0010111
+    OP_JAL    = 0x6F,  // 1101111
+    OP_JALR   = 0x67,  // 1100111
+    OP_VETOR  = 0x27,  // 0100111 (extensão personalizada)
+    OP_MEM_PI = 0x0B,  // 0001011 custom-0: lw.pi, ld.par (tipo I)
+    OP_SW_PI  = 0x2B,  // 0101011 custom-1: sw.pi (tipo S)
+    OP_SYSTEM = 0x73   // 1110011 (ecall/ebreak = parada)
+};
+
+// --- INSTRUÇÃO ---
+struct Instrucao {
+    int linha;                  // Linha do .s (para mensagens)
+    std::string rotulo;         // Rótulo(s) que apontam para ela (só no comentário)
+    std::string mnem;
+    std::vector<std::string> ops;
+    std::string texto;          // "mnem op1, op2" para o comentário do .hex
+    uint32_t bits = 0;
+
+    // Campos crus (o hazard_unit compara estes) e o que realmente é lido/escrito
+    uint8_t f_rd = 0, f_rs1 = 0, f_rs2 = 0;
+    bool usa_rs1 = false, usa_rs2 = false, reads_rd = false;
+    uint8_t def1 = 0, def2 = 0; // Registradores escritos (0 = nenhum)
+    bool load = false;          // mem_read: rd vem da memória
+    uint8_t load_rd2 = 0;       // ld.par: rd+1 também vem da memória
+
+    // Acesso à memória (para a ordem entre loads/stores)
+    bool acessa = false, escreve = false;
+    uint8_t base = 0;
+    int32_t desloc = 0;
+    int tam = 0;
+
+    bool terminador = false;    // Desvio, jal, jalr, ecall/ebreak
+    bool desvio = false;        // Desvio condicional ou jalr (compara/usa rs em EX)
+    bool fixa = false;          // auipc: não pode mudar de posição
+    bool bit30_tipo_i = false;  // Tipo I com bit 30 = 1 (alu_control.v faria SUB)
+};
+
+// --- ERROS ---
+static const char* g_arquivo = "";
+
+[[noreturn]] static void erro(int linha, const std::string& msg) {
+    std::printf("[ERRO] %s:%d: %s\n", g_arquivo, linha, msg.c_str());
+    std::exit(1);
+}
+
+// --- LEITURA DO .s ---
+static std::string aparar(const std::string& s) {
+    size_t i = 0, j = s.size();
+    while (i < j && std::isspace((unsigned char)s[i])) i++;
+    while (j > i && std::isspace((unsigned char)s[j - 1])) j--;
+    return s.substr(i, j - i);
+}
+
+static int registrador(const std::string& s, int linha) {
+    static const std::map<std::string, int> abi = {
+        {"zero", 0}, {"ra", 1}, {"sp", 2}, {"gp", 3}, {"tp", 4},
+        {"t0", 5}, {"t1", 6}, {"t2", 7}, {"s0", 8}, {"fp", 8}, {"s1", 9},
+        {"a0", 10}, {"a1", 11}, {"a2", 12}, {"a3", 13}, {"a4", 14}, {"a5", 15},
+        {"a6", 16}, {"a7", 17}, {"s2", 18}, {"s3", 19}, {"s4", 20}, {"s5", 21},
+        {"s6", 22}, {"s7", 23}, {"s8", 24}, {"s9", 25}, {"s10", 26}, {"s11", 27},
+        {"t3", 28}, {"t4", 29}, {"t5", 30}, {"t6", 31}
+    };
+    if (s.size() >= 2 && s[0] == 'x') {
+        char* fim;
+        long r = std::strtol(s.c_str() + 1, &fim, 10);
+        if (*fim == '\0' && r >= 0 && r < 32) return (int)r;
+    }
+    auto it = abi.find(s);
+    if (it == abi.end()) erro(linha, "registrador inválido '" + s + "'");
+    return it->second;
+}
+
+static bool eh_numero(const std::string& s) {
+    if (s.empty()) return false;
+    size_t i = (s[0] == '-' || s[0] == '+') ? 1 : 0;
+    return i < s.size() && std::isdigit((unsigned char)s[i]);
+}
+
+static int64_t numero(const std::string& s, int linha) {
+    char* fim;
+    long long v = std::strtoll(s.c_str(), &fim, 0);
+    if (s.empty() || *fim != '\0') erro(linha, "número inválido '" + s + "'");
+    return v;
+}
+
+// "imm(rs1)" -> (imm, rs1)
+static void endereco(const std::string& s, int linha, int64_t& imm, int& base) {
+    size_t a = s.find('('), f = s.find(')');
+    if (a == std::string::npos || f == std::string::npos || f < a) erro(linha, "esperado imm(rs1), veio '" + s + "'");
+    std::string off = aparar(s.substr(0, a));
+    imm = off.empty() ? 0 : numero(off, linha);
+    base = registrador(aparar(s.substr(a + 1, f - a - 1)), linha);
+}
+
+static std::string juntar(const std::string& mnem, const std::vector<std::string>& ops) {
+    std::string t = mnem;
+    for (size_t i = 0; i < ops.size(); i++) t += (i ? ", " : " ") + ops[i];
+    return t;
+}
+
+// Lê o .s, expande as pseudo-instruções e preenche o mapa de rótulos (endereço em bytes)
+static std::vector<Instrucao> ler_programa(const char* caminho, std::map<std::string, uint32_t>& rotulos) {
+    std::ifstream f(caminho);
+    if (!f) {
+        std::printf("[ERRO] Não foi possível abrir %s\n", caminho);
+        std::exit(1);
+    }
+    std::vector<Instrucao> prog;
+    std::string linha, pendente;
+    int n = 0;
+    while (std::getline(f, linha)) {
+        n++;
+        size_t c = linha.find('#');
+        if (c != std::string::npos) linha.erase(c);
+        c = linha.find("//");
+        if (c != std::string::npos) linha.erase(c);
+        linha = aparar(linha);
+
+        // Rótulos (pode haver mais de um, e a instrução pode vir na mesma linha)
+        size_t dp;
+        while ((dp = linha.find(':')) != std::string::npos) {
+            std::string r = aparar(linha.substr(0, dp));
+            if (r.empty() || r.find_first_of(" \t,()") != std::string::npos) erro(n, "rótulo inválido '" + r + "'");
+            if (rotulos.count(r)) erro(n, "rótulo repetido '" + r + "'");
+            rotulos[r] = (uint32_t)prog.size() * 4;
+            pendente += r + ": ";
+            linha = aparar(linha.substr(dp + 1));
+        }
+        if (linha.empty()) continue;
+
+        Instrucao in;
+        in.linha = n;
+        size_t esp = linha.find_first_of(" \t");
+        in.mnem = linha.substr(0, esp);
+        for (char& ch : in.mnem) ch = (char)std::tolower((unsigned char)ch);
+        if (esp != std::string::npos) {
+            std::string resto = linha.substr(esp);
+            size_t ini = 0;
+            while (true) {
+                size_t v = resto.find(',', ini);
+                std::string op = aparar(resto.substr(ini, v == std::string::npos ? std::string::npos : v - ini));
+                if (op.empty()) erro(n, "operando vazio");
+                in.ops.push_back(op);
+                if (v == std::string::npos) break;
+                ini = v + 1;
+            }
+        }
+
+        // Pseudo-instruções
+        auto empilha = [&](const std::string& m, std::vector<std::string> ops) {
+            Instrucao p;
+            p.linha = n;
+            p.mnem = m;
+            p.ops = std::move(ops);
+            p.rotulo = pendente;
+            pendente.clear();
+            prog.push_back(p);
+        };
+        const std::string& m = in.mnem;
+        const auto& o = in.ops;
+        if (m == "nop") empilha("addi", {"x0", "x0", "0"});
+        else if (m == "mv" && o.size() == 2) empilha("addi", {o[0], o[1], "0"});
+        else if (m == "j" && o.size() == 1) empilha("jal", {"x0", o[0]});
+        else if (m == "jr" && o.size() == 1) empilha("jalr", {"x0", o[0], "0"});
+        else if (m == "ret" && o.empty()) empilha("jalr", {"x0", "x1", "0"});
+        else if (m == "beqz" && o.size() == 2) empilha("beq", {o[0], "x0", o[1]});
+        else if (m == "bnez" && o.size() == 2) empilha("bne", {o[0], "x0", o[1]});
+        else if (m == "jal" && o.size() == 1) empilha("jal", {"x1", o[0]});
+        else if (m == "li" && o.size() == 2) {
+            int64_t v = numero(o[1], n);
+            if (v < INT32_MIN || v > UINT32_MAX) erro(n, "li fora de 32 bits");
+            int32_t v32 = (int32_t)(uint32_t)v;
+            if (v32 >= -2048 && v32 < 2048) {
+                empilha("addi", {o[0], "x0", std::to_string(v32)});
+            } else {
+                // lui com arredondamento, porque o addi estende o sinal dos 12 bits baixos
+                int32_t baixo = (int32_t)((uint32_t)v32 << 20) >> 20;
+                uint32_t alto = ((uint32_t)v32 - (uint32_t)baixo) >> 12;
+                empilha("lui", {o[0], std::to_string(alto)});
+                if (baixo) empilha("addi", {o[0], o[0], std::to_string(baixo)});
+            }
+        }
+        else empilha(in.mnem, in.ops);
+    }
+    if (!pendente.empty()) erro(n, "rótulo no fim do arquivo sem instrução");
+    return prog;
+}
+
+// --- CODIFICAÇÃO ---
+static uint32_t tipo_r(uint32_t f7, uint32_t rs2, uint32_t rs1, uint32_t f3, uint32_t rd, uint32_t op) {
+    return (f7 << 25) | (rs2 << 20) | (rs1 << 15) | (f3 << 12) | (rd << 7) | op;
+}
+static uint32_t tipo_i(int32_t imm, uint32_t rs1, uint32_t f3, uint32_t rd, uint32_t op) {
+    return ((uint32_t)(imm & 0xFFF) << 20) | (rs1 << 15) | (f3 << 12) | (rd << 7) | op;
+}
+static uint32_t tipo_s(int32_t imm, uint32_t rs2, uint32_t rs1, uint32_t f3, uint32_t op) {
+    return ((uint32_t)((imm >> 5) & 0x7F) << 25) | (rs2 << 20) | (rs1 << 15) | (f3 << 12) |
+           ((uint32_t)(imm & 0x1F) << 7) | op;
+}
+static uint32_t tipo_b(int32_t imm, uint32_t rs2, uint32_t rs1, uint32_t f3) {
+    return ((uint32_t)((imm >> 12) & 1) << 31) | ((uint32_t)((imm >> 5) & 0x3F) << 25) | (rs2 << 20) |
+           (rs1 << 15) | (f3 << 12) | ((uint32_t)((imm >> 1) & 0xF) << 8) |
+           ((uint32_t)((imm >> 11) & 1) << 7) | OP_BRANCH;
+}
+static uint32_t tipo_j(int32_t imm, uint32_t rd) {
+    return ((uint32_t)((imm >> 20) & 1) << 31) | ((uint32_t)((imm >> 1) & 0x3FF) << 21) |
+           ((uint32_t)((imm >> 11) & 1) << 20) | ((uint32_t)((imm >> 12) & 0xFF) << 12) | (rd << 7) | OP_JAL;
+}
+
+// Monta uma instrução no endereço pc e preenche os campos usados pelo escalonador
+static void montar(Instrucao& in, uint32_t pc, const std::map<std::string, uint32_t>& rotulos) {
+    // {funct7, funct3}
+    static const std::map<std::string, std::pair<int, int>> tab_r = {
+        {"add", {0x00, 0}}, {"sub", {0x20, 0}}, {"sll", {0x00, 1}}, {"slt", {0x00, 2}},
+        {"sltu", {0x00, 3}}, {"xor", {0x00, 4}}, {"srl", {0x00, 5}}, {"sra", {0x20, 5}},
+        {"or", {0x00, 6}}, {"and", {0x00, 7}},
+        // Extensão vetorial: tabela do alu_control.v, {funct7, funct3}
+        {"vadd.8", {0, 0}}, {"vadd.16", {0, 1}}, {"vsub.8", {0, 2}}, {"vsub.16", {0, 3}},
+        {"vand.8", {0, 4}}, {"vand.16", {0, 5}}, {"vor.8", {0, 6}}, {"vor.16", {0, 7}},
+        {"vmul.8", {1, 0}}, {"vmul.16", {1, 1}}, {"vdot.8", {1, 2}}, {"vdot.16", {1, 3}}
+    };
+    static const std::map<std::string, int> tab_i = {
+        {"addi", 0}, {"slti", 2}, {"sltiu", 3}, {"xori", 4}, {"ori", 6}, {"andi", 7},
+        {"slli", 1}, {"srli", 5}, {"srai", 5}
+    };
+    static const std::map<std::string, int> tab_load = {{"lb", 0}, {"lh", 1}, {"lw", 2}, {"lbu", 4}, {"lhu", 5}};
+    static const std::map<std::string, int> tab_store = {{"sb", 0}, {"sh", 1}, {"sw", 2}};
+    static const std::map<std::string, int> tab_b = {
+        {"beq", 0}, {"bne", 1}, {"blt", 4}, {"bge", 5}, {"bltu", 6}, {"bgeu", 7}
+    };
+
+    const std::string& m = in.mnem;
+    const auto& o = in.ops;
+    int L = in.linha;
+    auto exige = [&](size_t n) {
+        if (o.size() != n) erro(L, m + " espera " + std::to_string(n) + " operandos");
+    };
+    auto imm12 = [&](int64_t v) {
+        if (v < -2048 || v > 2047) erro(L, "imediato fora de 12 bits: " + std::to_string(v));
+        return (int32_t)v;
+    };
+    auto alvo = [&](const std::string& s) -> int64_t {
+        auto it = rotulos.find(s);
+        if (it != rotulos.end()) return (int64_t)it->second - pc;
+        if (eh_numero(s)) return numero(s, L);
+        erro(L, "rótulo desconhecido '" + s + "'");
+    };
+    in.texto = juntar(m, o);
+
+    if (tab_r.count(m)) {
+        exige(3);
+        auto f = tab_r.at(m);
+        bool vetor = m[0] == 'v';
+        in.bits = tipo_r(f.first, registrador(o[2], L), registrador(o[1], L), f.second,
+                         registrador(o[0], L), vetor ? OP_VETOR : OP_R);
+    } else if (tab_i.count(m)) {
+        exige(3);
+        int f3 = tab_i.at(m);
+        int64_t v = numero(o[2], L);
+        int32_t imm;
+        if (f3 == 1 || f3 == 5) {
+            if (v < 0 || v > 31) erro(L, "deslocamento fora de 0..31");
+            imm = (int32_t)v | (m == "srai" ? 0x400 : 0);
+        } else {
+            imm = imm12(v);
+        }
+        in.bits = tipo_i(imm, registrador(o[1], L), f3, registrador(o[0], L), OP_I);
+    } else if (tab_load.count(m) || m == "lw.pi" || m == "ld.par") {
+        exige(2);
+        int64_t v; int base;
+        endereco(o[1], L, v, base);
+        int rd = registrador(o[0], L);
+        if (m == "ld.par" && rd == 31) erro(L, "ld.par escreve rd e rd+1: rd não pode ser x31");
+        uint32_t op = tab_load.count(m) ? OP_LOAD : OP_MEM_PI;
+        int f3 = tab_load.count(m) ? tab_load.at(m) : (m == "lw.pi" ? 2 : 3);
+        in.bits = tipo_i(imm12(v), base, f3, rd, op);
+    } else if (tab_store.count(m) || m == "sw.pi") {
+        exige(2);
+        int64_t v; int base;
+        endereco(o[1], L, v, base);
+        uint32_t op = (m == "sw.pi") ? OP_SW_PI : OP_STORE;
+        int f3 = (m == "sw.pi") ? 2 : tab_store.at(m);
+        in.bits = tipo_s(imm12(v), registrador(o[0], L), base, f3, op);
+    } else if (tab_b.count(m)) {
+        exige(3);
+        int64_t d = alvo(o[2]);
+        if (d < -4096 || d > 4094 || (d & 1)) erro(L, "alvo de desvio fora de alcance");
+        in.bits = tipo_b((int32_t)d, registrador(o[1], L), registrador(o[0], L), tab_b.at(m));
+    } else if (m == "lui" || m == "auipc") {
+        exige(2);
+        int64_t v = numero(o[1], L);
+        if (v < -524288 || v > 0xFFFFF) erro(L, "imediato fora de 20 bits");
+        in.bits = ((uint32_t)(v & 0xFFFFF) << 12) | ((uint32_t)registrador(o[0], L) << 7) |
+                  (m == "lui" ? OP_LUI : OP_AUIPC);
+    } else if (m == "jal") {
+        exige(2);
+        int64_t d = alvo(o[1]);
+        if (d < -(1 << 20) || d >= (1 << 20) || (d & 1)) erro(L, "alvo de jal fora de alcance");
+        in.bits = tipo_j((int32_t)d, registrador(o[0], L));
+    } else if (m == "jalr") {
+        int64_t v; int base;
+        if (o.size() == 2) endereco(o[1], L, v, base);
+        else { exige(3); base = registrador(o[1], L); v = numero(o[2], L); }
+        in.bits = tipo_i(imm12(v), base, 0, registrador(o[0], L), OP_JALR);
+    } else if (m == "ecall" || m == "ebreak") {
+        exige(0);
+        in.bits = (m == "ecall") ? 0x00000073u : 0x00100073u;
+    } else {
+        erro(L, "instrução desconhecida '" + m + "'");
+    }
+
+    // --- Campos para o escalonador (mesma decodificação do simulador.cpp) ---
+    uint32_t b = in.bits;
+    uint8_t opc = b & 0x7F, f3 = (b >> 12) & 7;
+    in.f_rd = (b >> 7) & 0x1F;
+    in.f_rs1 = (b >> 15) & 0x1F;
+    in.f_rs2 = (b >> 20) & 0x1F;
+    int32_t imm = (int32_t)b >> 20;
+    uint8_t rd = in.f_rd;
+    switch (opc) {
+        case OP_R: case OP_VETOR:
+            in.usa_rs1 = in.usa_rs2 = true; in.def1 = rd;
+            in.reads_rd = (opc == OP_VETOR) && ((b >> 25) == 1) && ((f3 >> 1) == 1);  // vdot
+            break;
+        case OP_I:
+            in.usa_rs1 = true; in.def1 = rd;
+            in.bit30_tipo_i = f3 != 5 && ((b >> 30) & 1);
+            break;
+        case OP_LOAD:
+            in.usa_rs1 = true; in.def1 = rd; in.load = true;
+            in.acessa = true; in.base = in.f_rs1; in.desloc = imm; in.tam = 1 << (f3 & 3);
+            break;
+        case OP_MEM_PI:
+            in.usa_rs1 = true; in.def1 = rd; in.load = true;
+            in.acessa = true; in.base = in.f_rs1;
+            if (f3 == 3) {  // ld.par: rd, rd+1 = M[rs1+imm], M[rs1+imm+4]
+                in.def2 = (rd + 1) & 0x1F; in.load_rd2 = in.def2;
+                in.desloc = imm; in.tam = 8;
+            } else {        // lw.pi: rd = M[rs1], rs1 += imm
+                in.def2 = in.f_rs1; in.desloc = 0; in.tam = 4;
+            }
+            break;
+        case OP_STORE: case OP_SW_PI:
+            in.usa_rs1 = in.usa_rs2 = true;
+            in.acessa = in.escreve = true; in.base = in.f_rs1;
+            in.desloc = (opc == OP_SW_PI) ? 0 : (((int32_t)(b & 0xFE000000) >> 20) | ((b >> 7) & 0x1F));
+            in.tam = (opc == OP_SW_PI) ? 4 : 1 << (f3 & 3);
+            if (opc == OP_SW_PI) in.def2 = in.f_rs1;
+            break;
+        case OP_BRANCH:
+            in.usa_rs1 = in.usa_rs2 = true; in.terminador = in.desvio = true;
+            break;
+        case OP_LUI:
+            in.def1 = rd;
+            break;
+        case OP_AUIPC:
+            in.def1 = rd; in.fixa = true;
+            break;
+        case OP_JAL:
+            in.def1 = rd; in.terminador = true;
+            break;
+        case OP_JALR:
+            in.usa_rs1 = true; in.def1 = rd; in.terminador = in.desvio = true;
+            break;
+        case OP_SYSTEM:
+            in.terminador = true;
+            break;
+    }
+}
+
+// --- REGRAS DE HAZARD (hazard_unit.v) ---
+// Stall de 1 ciclo se p (em EX) é load e n (em ID) tem o registrador carregado
+// num campo cru rs1/rs2, ou no rd quando n lê o acumulador (vdot)
+static bool stall(const Instrucao& p, const Instrucao& n) {
+    if (!p.load) return false;
+    auto compara = [&n](uint8_t r) {
+        return r != 0 && (r == n.f_rs1 || r == n.f_rs2 || (n.reads_rd && r == n.f_rd));
+    };
+    return compara(p.f_rd) || compara(p.load_rd2);
+}
+
+static bool le(const Instrucao& in, uint8_t r) {
+    return r != 0 && ((in.usa_rs1 && in.f_rs1 == r) || (in.usa_rs2 && in.f_rs2 == r) ||
+                      (in.reads_rd && in.f_rd == r));
+}
+
+static bool escreve(const Instrucao& in, uint8_t r) {
+    return r != 0 && (in.def1 == r || in.def2 == r);
+}
+
+// --- CONTAGEM ESTÁTICA ---
+struct Contagem {
+    int stalls = 0;
+    int antes_desvio = 0;   // Load logo antes de desvio/jalr que usa o valor
+    int wb_id = 0;          // Dependência a 3 instruções (WB escreve quando ID lê)
+};
+
+static Contagem contar(const std::vector<const Instrucao*>& ordem) {
+    Contagem c;
+    for (size_t i = 0; i + 1 < ordem.size(); i++) {
+        if (stall(*ordem[i], *ordem[i + 1])) {
+            c.stalls++;
+            if (ordem[i + 1]->desvio) c.antes_desvio++;
+        }
+    }
+    // regfile.v não tem bypass: o produtor em WB e o consumidor em ID no mesmo
+    // ciclo leem o valor antigo (o simulador trata como escreve-antes-de-lê)
+    for (size_t i = 0; i + 3 < ordem.size(); i++) {
+        const Instrucao& p = *ordem[i];
+        bool sequencial = true;
+        for (size_t k = i; k < i + 3; k++) sequencial &= !ordem[k]->terminador;
+        if (!sequencial) continue;
+        uint8_t regs[2] = {p.def1, p.def2};
+        for (uint8_t r : regs) {
+            if (r && le(*ordem[i + 3], r) && !escreve(*ordem[i + 1], r) && !escreve(*ordem[i + 2], r)) {
+                c.wb_id++;
+                break;
+            }
+        }
+    }
+    return c;
+}
+
+// --- ESCALONAMENTO (list scheduling por bloco básico) ---
+// Duas operações de memória podem trocar de ordem?
+static bool memoria_independente(const Instrucao& a, int versao_a, const Instrucao& b, int versao_b) {
+    if (!a.escreve && !b.escreve) return true;
+    // Mesma base sem escrita no meio: compara as faixas de endereço
+    if (a.base == b.base && versao_a == versao_b) {
+        return a.desloc + a.tam <= b.desloc || b.desloc + b.tam <= a.desloc;
+    }
+    return false;
+}
+
+// Reordena bloco[0..n) e devolve a nova ordem. antes = até 3 instruções que
+// precedem o bloco na ROM, depois = até 3 que o seguem (ordem do fonte).
+static std::vector<const Instrucao*> escalonar_bloco(const std::vector<const Instrucao*>& bloco,
+                                                     const std::vector<const Instrucao*>& antes,
+                                                     const std::vector<const Instrucao*>& depois) {
+    size_t n = bloco.size();
+    bool tem_term = bloco.back()->terminador;
+    size_t corpo = tem_term ? n - 1 : n;
+    if (corpo < 2) return bloco;
+
+    // Versão da base de cada acesso: índice da última escrita na base dentro do bloco
+    std::vector<int> versao(n, -1);
+    {
+        int ultima[32];
+        for (int& u : ultima) u = -1;
+        for (size_t i = 0; i < n; i++) {
+            versao[i] = ultima[bloco[i]->base];
+            if (bloco[i]->def1) ultima[bloco[i]->def1] = (int)i;
+            if (bloco[i]->def2) ultima[bloco[i]->def2] = (int)i;
+        }
+    }
+
+    // Grafo de dependências (i -> j, i < j) com latência: 2 para load -> uso
+    std::vector<std::vector<std::pair<size_t, int>>> succ(n);
+    std::vector<int> npred(n, 0);
+    for (size_t j = 0; j < n; j++) {
+        const Instrucao& b = *bloco[j];
+        for (size_t i = 0; i < j; i++) {
+            const Instrucao& a = *bloco[i];
+            bool raw = le(b, a.def1) || le(b, a.def2);
+            bool war = (b.def1 && le(a, b.def1)) || (b.def2 && le(a, b.def2));
+            bool waw = escreve(a, b.def1) || escreve(a, b.def2);
+            bool mem = a.acessa && b.acessa && !memoria_independente(a, versao[i], b, versao[j]);
+            bool term = (j == n - 1 && tem_term);
+            if (raw || war || waw || mem || term) {
+                bool carregado = a.load && (le(b, a.def1) || (a.load_rd2 && le(b, a.load_rd2)));
+                succ[i].push_back({j, carregado ? 2 : 1});
+                npred[j]++;
+            }
+        }
+    }
+
+    // Prioridade: maior caminho (em ciclos) até o fim do bloco
+    std::vector<int> altura(n, 0);
+    for (size_t k = n; k-- > 0;) {
+        for (auto& s : succ[k]) altura[k] = std::max(altura[k], s.second + altura[s.first]);
+    }
+
+    // hist = instruções já emitidas (contexto + escolhidas), para olhar 3 atrás
+    std::vector<const Instrucao*> hist(antes);
+    std::vector<const Instrucao*> ordem;
+    std::vector<bool> feito(n, false);
+    for (size_t passo = 0; passo < corpo; passo++) {
+        size_t melhor = n;
+        int melhor_custo = 0;
+        bool melhor_risco = false;
+        const Instrucao* prev = hist.empty() ? nullptr : hist.back();
+        for (size_t i = 0; i < corpo; i++) {
+            if (feito[i] || npred[i] > 0) continue;
+            int custo = (prev && stall(*prev, *bloco[i])) ? 1 : 0;
+            // Última vaga antes do terminador: não pode ser um load que ele usa
+            if (tem_term && passo == corpo - 1 && stall(*bloco[i], *bloco[n - 1])) custo++;
+            // Leitura WB->ID que o regfile.v não resolve: pesa antes dos stalls,
+            // porque muda o resultado no RTL (o stall só custa um ciclo)
+            bool risco = false;
+            size_t h = hist.size();
+            if (h >= 3 && !hist[h - 3]->terminador && !hist[h - 2]->terminador && !hist[h - 1]->terminador) {
+                const Instrucao& p = *hist[h - 3];
+                for (uint8_t r : {p.def1, p.def2}) {
+                    risco |= r && le(*bloco[i], r) && !escreve(*hist[h - 2], r) && !escreve(*hist[h - 1], r);
+                }
+            }
+            if (melhor == n || risco < melhor_risco ||
+                (risco == melhor_risco && custo < melhor_custo) ||
+                (risco == melhor_risco && custo == melhor_custo && altura[i] > altura[melhor])) {
+                melhor = i;
+                melhor_custo = custo;
+                melhor_risco = risco;
+            }
+        }
+        feito[melhor] = true;
+        ordem.push_back(bloco[melhor]);
+        hist.push_back(bloco[melhor]);
+        for (auto& s : succ[melhor]) npred[s.first]--;
+    }
+    if (tem_term) ordem.push_back(bloco[n - 1]);
+
+    // Só aceita se tirar algum stall (internos e nas bordas do bloco) sem
+    // aumentar as leituras WB->ID; fora isso a ordem do fonte fica como está
+    auto custo_total = [&antes, &depois](const std::vector<const Instrucao*>& o) {
+        std::vector<const Instrucao*> c(antes);
+        c.insert(c.end(), o.begin(), o.end());
+        c.insert(c.end(), depois.begin(), depois.end());
+        return contar(c);
+    };
+    Contagem novo = custo_total(ordem), velho = custo_total(bloco);
+    return (novo.stalls < velho.stalls && novo.wb_id <= velho.wb_id) ? ordem : bloco;
+}
+
+// --- SAÍDA ---
+static void gravar_hex(const char* caminho, const char* fonte, const std::vector<const Instrucao*>& ordem,
+                       const Contagem& antes, const Contagem& depois, bool escalonado, bool cru) {
+    FILE* f = std::fopen(caminho, "w");
+    if (!f) {
+        std::printf("[ERRO] Não foi possível criar %s\n", caminho);
+        std::exit(1);
+    }
+    if (cru) {
+        // Formato "v2.0 raw" do Digital/Logisim, só as palavras
+        std::fprintf(f, "v2.0 raw\n");
+        for (const Instrucao* in : ordem) std::fprintf(f, "%08x\n", in->bits);
+    } else {
+        std::fprintf(f, "# %s - gerado pelo montador a partir de %s\n", caminho, fonte);
+        if (escalonado) {
+            std::fprintf(f, "# stalls load-use estáticos: %d -> %d (escalonado)\n", antes.stalls, depois.stalls);
+        } else {
+            std::fprintf(f, "# stalls load-use estáticos: %d (sem escalonamento)\n", depois.stalls);
+        }
+        for (const Instrucao* in : ordem) {
+            std::fprintf(f, "%08x  # %s%s\n", in->bits, in->rotulo.c_str(), in->texto.c_str());
+        }
+    }
+    std::fclose(f);
+}
+
+static void uso(const char* prog) {
+    std::printf("Uso: %s programa.s [-o programa.hex] [-n] [-v] [-b]\n", prog);
+    std::printf("  -o  arquivo de saída (padrão: troca .s por .hex)\n");
+    std::printf("  -n  não escalona (só monta, na ordem do fonte)\n");
+    std::printf("  -v  lista a ordem final e marca os stalls restantes\n");
+    std::printf("  -b  saída crua \"v2.0 raw\" (sem comentários) para a ROM do Digital\n");
+}
+
+// --- FUNÇÃO PRINCIPAL ---
+int main(int argc, char** argv) {
+    const char* fonte = nullptr;
+    std::string saida;
+    bool escalonar = true, detalhes = false, cru = false;
+
+    for (int a = 1; a < argc; a++) {
+        if (!std::strcmp(argv[a], "-o") && a + 1 < argc) saida = argv[++a];
+        else if (!std::strcmp(argv[a], "-n")) escalonar = false;
+        else if (!std::strcmp(argv[a], "-v")) detalhes = true;
+        else if (!std::strcmp(argv[a], "-b")) cru = true;
+        else if (argv[a][0] != '-' && !fonte) fonte = argv[a];
+        else { uso(argv[0]); return 1; }
+    }
+    if (!fonte) { uso(argv[0]); return 1; }
+    if (saida.empty()) {
+        saida = fonte;
+        size_t p = saida.rfind(".s");
+        if (p != std::string::npos && p == saida.size() - 2) saida.erase(p);
+        saida += ".hex";
+    }
+    g_arquivo = fonte;
+
+    std::map<std::string, uint32_t> rotulos;
+    std::vector<Instrucao> prog = ler_programa(fonte, rotulos);
+    if (prog.empty()) {
+        std::printf("[ERRO] %s não tem instruções\n", fonte);
+        return 1;
+    }
+    // Desvios e jal são terminadores e não mudam de lugar, então os
+    // deslocamentos calculados aqui continuam valendo depois do escalonamento
+    for (size_t i = 0; i < prog.size(); i++) montar(prog[i], (uint32_t)i * 4, rotulos);
+
+    std::vector<const Instrucao*> original;
+    for (const Instrucao& in : prog) original.push_back(&in);
+
+    // Blocos básicos: [inicio, fim)
+    std::vector<std::pair<size_t, size_t>> blocos;
+    size_t ini = 0;
+    for (size_t i = 0; i < prog.size(); i++) {
+        bool rotulo_aqui = !prog[i].rotulo.empty() && i > ini;
+        if (rotulo_aqui || (prog[i].fixa && i > ini)) {
+            blocos.push_back({ini, i});
+            ini = i;
+        }
+        if (prog[i].terminador || prog[i].fixa) {
+            blocos.push_back({ini, i + 1});
+            ini = i + 1;
+        }
+    }
+    if (ini < prog.size()) blocos.push_back({ini, prog.size()});
+
+    std::vector<const Instrucao*> final_;
+    for (auto& b : blocos) {
+        std::vector<const Instrucao*> bloco(original.begin() + b.first, original.begin() + b.second);
+        std::vector<const Instrucao*> antes(final_.end() - std::min<size_t>(3, final_.size()), final_.end());
+        std::vector<const Instrucao*> depois(original.begin() + b.second,
+                                             original.begin() + std::min(b.second + 3, original.size()));
+        if (escalonar && !bloco.front()->fixa) bloco = escalonar_bloco(bloco, antes, depois);
+        final_.insert(final_.end(), bloco.begin(), bloco.end());
+    }
+    // O rótulo continua no início do bloco, seja qual for a instrução que ficou lá
+    std::vector<std::string> rotulos_pos(final_.size());
+    for (auto& b : blocos) rotulos_pos[b.first] = original[b.first]->rotulo;
+    std::vector<Instrucao> copia;
+    copia.reserve(final_.size());
+    for (size_t i = 0; i < final_.size(); i++) {
+        copia.push_back(*final_[i]);
+        copia.back().rotulo = rotulos_pos[i];
+    }
+    for (size_t i = 0; i < final_.size(); i++) final_[i] = &copia[i];
+
+    Contagem antes = contar(original), depois = contar(final_);
+    int movidas = 0, bit30 = 0;
+    for (size_t i = 0; i < final_.size(); i++) {
+        if (final_[i]->linha != original[i]->linha || final_[i]->texto != original[i]->texto) movidas++;
+        if (final_[i]->bit30_tipo_i) bit30++;
+    }
+
+    gravar_hex(saida.c_str(), fonte, final_, antes, depois, escalonar, cru);
+
+    if (detalhes) {
+        std::printf("\n--- Ordem final ---\n");
+        for (size_t i = 0; i < final_.size(); i++) {
+            const Instrucao& in = *final_[i];
+            bool st = i + 1 < final_.size() && stall(in, *final_[i + 1]);
+            std::printf("%04zx  %08x  %-10s %-28s (linha %d)%s\n", i * 4, in.bits, in.rotulo.c_str(),
+                        in.texto.c_str(), in.linha, st ? "  <- stall" : "");
+        }
+    }
+
+    std::printf("\n==========================================================\n");
+    std::printf("           MONTADOR RISC-V (RV32I + VETORIAL)\n");
+    std::printf("==========================================================\n");
+    std::printf("Fonte / saída:           %s -> %s\n", fonte, saida.c_str());
+    std::printf("Instruções:              %zu\n", final_.size());
+    std::printf("Blocos básicos:          %zu\n", blocos.size());
+    std::printf("Escalonamento:           %s\n", escalonar ? "list scheduling (hazard_unit/foward_unit)" : "desligado (-n)");
+    std::printf("Instruções movidas:      %d\n", movidas);
+    std::printf("\n--- Stalls estáticos (1 ciclo cada) ---\n");
+    std::printf("                         antes   depois\n");
+    std::printf("Load-use:                %5d   %6d\n", antes.stalls, depois.stalls);
+    std::printf("  ... antes de desvio:   %5d   %6d\n", antes.antes_desvio, depois.antes_desvio);
+    std::printf("\n--- Diferenças em relação aos módulos Verilog ---\n");
+    std::printf("Leituras WB->ID (dist. 3): %3d   %6d  (regfile.v sem bypass lê o valor antigo)\n",
+                antes.wb_id, depois.wb_id);
+    std::printf("Tipo I com bit 30 = 1:   %5d            (alu_control.v faria SUB)\n", bit30);
+    return 0;
+}
@@ -9,4 +9,20 @@ module pc(
         if (reset) pc <= 0;
         else if (pc_write) pc <= next_pc;
     end
-endmodule
\ No newline at end of file
+endmodule
+
+
+// next_pc - Seleção do próximo PC da busca
+// Prioridade: recuperação de predição errada (EX) > alvo previsto (IF) > pc + 4
+module next_pc(
+    input [31:0] pc,
+    input pred_taken,          // Do branch_predictor
+    input [31:0] pred_target,
+    input pc_recover,          // Do pipeline_ctrl
+    input [31:0] correct_pc,   // Do branch_check
+    output [31:0] next_pc
+);
+    assign next_pc = pc_recover ? correct_pc :
+                     pred_taken ? pred_target :
+                     pc + 4;
+endmodule
@@ -4,17 +4,27 @@ module regfile(
     input we,
     input [4:0] rs1,
     input [4:0] rs2,
+    input [4:0] rs3,       // Terceira leitura: campo rd (acumulador do vdot)
     input [31:0] wd,
     input [4:0] rd,
+    input we2,             // Segunda escrita: base do pós-incremento / rd+1 do ld.par
+    input [31:0] wd2,
+    input [4:0] rd_w2,
     output [31:0] rd1,
-    output [31:0] rd2
+    output [31:0] rd2,
+    output [31:0] rd3
 );
     reg [31:0] regs [0:31];
     integer i;
     always @(posedge clk or posedge reset) begin
         if (reset) for (i=0; i<32; i=i+1) regs[i] <= 0;
-        else if (we && rd != 0) regs[rd] <= wd;
+        else begin
+            // Mesmo registrador nas duas portas: a porta 1 vence (última atribuição)
+            if (we2 && rd_w2 != 0) regs[rd_w2] <= wd2;
+            if (we && rd != 0) regs[rd] <= wd;
+        end
     end
     assign rd1 = (rs1 != 0) ? regs[rs1] : 0;
     assign rd2 = (rs2 != 0) ? regs[rs2] : 0;
+    assign rd3 = (rs3 != 0) ? regs[rs3] : 0;
 endmodule
\ No newline at end of file
@@ -0,0 +1,939 @@
+// simulador.cpp - Simulador ciclo a ciclo do pipeline RISC-V de 5 estágios
+//
+// Modela os mesmos registradores de pipeline do Verilog (if_id_reg, id_ex_reg,
+// ex_mem_reg, mem_wb_reg) e as mesmas regras de hazard_unit.v,
+// foward_unit.v (forwarding_unit) e pipeline_ctrl (Pipeline_control.v):
+//   - load-use: stall de 1 ciclo quando a instrução em EX é load e o rd dela
+//     bate com os campos rs1/rs2 da instrução em ID (campos crus, como no
+//     hardware: um tipo I também compara o campo rs2, que é parte do imediato)
+//   - forwarding de EX/MEM e MEM/WB para EX, prioridade MEM > WB
+//   - desvio resolvido em EX: flush de IF/ID e ID/EX (2 ciclos perdidos)
+//     quando a predição feita em IF estava errada
+//   - stall tem prioridade sobre predição errada, como no always @(*) do pipeline_ctrl
+//
+// Predição de desvios (branch_predictor.v): BTB de 2^BTB_BITS entradas e
+// tabela de contadores de 2 bits indexada por pc (bimodal) ou pc ^ histórico
+// global (gshare). "-p nenhum" reproduz o pipeline antigo (sempre não tomado).
+//
+// O caminho de dados segue a semântica RV32I + extensão vetorial
+// (opcode 7'b0100111). Onde os módulos ainda divergem do RV32I o simulador
+// usa o comportamento correto e conta/relata a diferença:
+//   - alu_control.v usa funct7[5] também em instruções tipo I, então
+//     addi com imediato negativo vira SUB no hardware
+//   - slt/sltu/slti/sltiu são mapeados para SUB no alu_control.v
+//   - regfile.v não tem bypass de escrita: um valor escrito em WB no mesmo
+//     ciclo em que ID lê o registrador chega atrasado. Aqui o banco é
+//     "escreve antes de ler" e os casos são contados no relatório
+//   - jal/jalr/auipc e os desvios além de beq/bne ainda não são decodificados
+//     por control_unit.v; pipeline_ctrl já tem as entradas jal_taken/jalr_taken
+//
+// ecall/ebreak encerram a simulação quando chegam em WB.
+//
+// Compilação: g++ -O2 -std=c++17 -o simulador simulador.cpp
+// Uso:        ./simulador programa.hex [-d dados.hex] [-m KB] [-c max_ciclos]
+//                                      [-p nenhum|bimodal|gshare] [-P]
+//                                      [-r] [-x endereco:palavras] [-t]
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// --- CONFIGURAÇÕES ---
+#define RAM_KB_PADRAO 1024              // Memória de dados (bytes = KB * 1024)
+#define MAX_CICLOS_PADRAO 2000000000ULL // Limite de segurança
+#define INSTR_NOP 0x00000013u           // addi x0, x0, 0 (o mesmo do flush de IF/ID)
+
+// --- PREDITOR (mesmos parâmetros do branch_predictor.v) ---
+#define BTB_BITS 6                      // 64 entradas na BTB
+#define PHT_BITS 8                      // 256 contadores de 2 bits / histórico de 8 bits
+
+// --- OPCODES ---
+enum Opcode : uint8_t {
+    OP_R      = 0x33,  // 0110011
+    OP_I      = 0x13,  // 0010011
+    OP_LOAD   = 0x03,  // 0000011
+    OP_STORE  = 0x23,  // 0100011
+    OP_BRANCH = 0x63,  // 1100011
+    OP_LUI    = 0x37,  // 0110111
+    OP_AUIPC  = 0x17,  // 0010111
+    OP_JAL    = 0x6F,  // 1101111
+    OP_JALR   = 0x67,  // 1100111
+    OP_VETOR  = 0x27,  // 0100111 (extensão personalizada)
+    OP_MEM_PI = 0x0B,  // 0001011 custom-0: lw.pi, ld.par (tipo I)
+    OP_SW_PI  = 0x2B,  // 0101011 custom-1: sw.pi (tipo S)
+    OP_SYSTEM = 0x73   // 1110011 (ecall/ebreak = parada)
+};
+
+// --- CÓDIGOS DA ALU (alu_ctrl[5:0], mesmo formato do alu.v) ---
+// [5:4] = modo (00 escalar, 01 4x8, 10 2x16), [3:0] = operação
+enum AluOp : uint8_t {
+    ALU_ADD  = 0x0, ALU_SUB = 0x1, ALU_AND = 0x2, ALU_OR  = 0x3,
+    ALU_XOR  = 0x4, ALU_SLL = 0x5, ALU_SRL = 0x6, ALU_SRA = 0x7,
+    ALU_LUI  = 0x8,
+    ALU_SLT  = 0x9, ALU_SLTU = 0xA  // Só no simulador (alu.v ainda não tem)
+};
+// Nos modos vetoriais 0100/0101 são vmul e vdot (mesmos bits de XOR/SLL no escalar)
+#define VOP_MUL 0x4
+#define VOP_DOT 0x5
+#define MODO_ESCALAR 0x00
+#define MODO_4X8     0x10
+#define MODO_2X16    0x20
+
+// --- INSTRUÇÃO PRÉ-DECODIFICADA ---
+// A ROM é decodificada uma vez no carregamento; os estágios só carregam um
+// ponteiro para cá. É isso que deixa o laço de ciclos na casa de dezenas de MIPS.
+struct Instrucao {
+    uint32_t bits;
+    uint8_t opcode, rd, rs1, rs2, funct3, funct7;
+    int32_t imm;
+    // Sinais da control_unit
+    bool reg_write, mem_to_reg, mem_read, mem_write, alu_src, branch, is_vector;
+    bool jal, jalr, auipc, parada;
+    uint8_t alu_ctrl;      // Saída do alu_control
+    bool usa_rs1, usa_rs2; // Campos que a instrução realmente lê
+    bool reads_rd;         // vdot: rd também é fonte (acumulador, 3ª leitura do banco)
+    // Segunda porta de escrita (lw.pi/sw.pi: base += imm, ld.par: rd+1 = palavra alta)
+    bool reg_write2, mem_to_reg2;
+    uint8_t rd2;
+    bool pos_incremento;   // Endereço = rs1 (sem imm); a ALU calcula rs1 + imm
+    bool par;              // Acesso de 64 bits (duas palavras)
+};
+
+// --- REGISTRADORES DE PIPELINE ---
+// instr == nullptr representa uma bolha (flush ou stall)
+// pred_* é a predição feita em IF, carregada até EX para a verificação
+struct Predicao {
+    bool taken;
+    uint32_t target;
+    uint32_t idx;             // Índice na PHT usado na consulta
+};
+
+struct IF_ID {
+    uint32_t pc;
+    const Instrucao* instr;
+    Predicao pred;
+};
+
+struct ID_EX {
+    uint32_t pc;
+    uint32_t read_data1, read_data2, read_data3;
+    const Instrucao* instr;   // Controle, imm, rs1/rs2/rd, funct3/funct7
+    Predicao pred;
+};
+
+struct EX_MEM {
+    uint32_t alu_result, write_data;
+    uint32_t mem_addr;        // alu_result, ou rs1 no pós-incremento
+    const Instrucao* instr;
+};
+
+struct MEM_WB {
+    uint32_t alu_result, mem_data, mem_data_hi;
+    const Instrucao* instr;
+};
+
+// --- ESTATÍSTICAS ---
+struct Estatisticas {
+    uint64_t ciclos = 0;
+    uint64_t instrucoes = 0;        // Retiradas em WB
+    uint64_t vetoriais = 0;
+    uint64_t loads = 0, stores = 0;
+    uint64_t bytes_mem = 0;         // Bytes lidos + escritos na RAM
+    uint64_t stalls_load_use = 0;
+    uint64_t stalls_falsos = 0;     // Stall por campo rs2 que a instrução não usa
+    uint64_t flushes = 0;           // Predições erradas (desvio, jal ou jalr)
+    uint64_t descartadas = 0;       // Instruções removidas de IF/ID e ID/EX
+    uint64_t desvios = 0, desvios_tomados = 0;
+    uint64_t saltos = 0;            // jal/jalr
+    uint64_t fwd_mem = 0, fwd_wb = 0;
+    uint64_t leitura_wb_id = 0;     // Dependências resolvidas pelo banco (WB -> ID)
+    uint64_t divergencias_addi = 0; // Tipo I com funct7[5]=1 (alu_control.v faria SUB)
+    uint64_t divergencias_slt = 0;  // slt/sltu (alu_control.v faria SUB)
+};
+
+// --- DECODIFICAÇÃO (control_unit + imm_gen + alu_control) ---
+static int32_t gerar_imediato(uint32_t in) {
+    switch (in & 0x7F) {
+        case OP_I: case OP_LOAD: case OP_JALR: case OP_MEM_PI:
+            return (int32_t)in >> 20;
+        case OP_STORE: case OP_SW_PI:
+            return ((int32_t)(in & 0xFE000000) >> 20) | ((in >> 7) & 0x1F);
+        case OP_BRANCH:
+            return ((int32_t)(in & 0x80000000) >> 19) | ((in & 0x80) << 4) |
+                   ((in >> 20) & 0x7E0) | ((in >> 7) & 0x1E);
+        case OP_LUI: case OP_AUIPC:
+            return (int32_t)(in & 0xFFFFF000);
+        case OP_JAL:
+            return ((int32_t)(in & 0x80000000) >> 11) | (in & 0xFF000) |
+                   ((in >> 9) & 0x800) | ((in >> 20) & 0x7FE);
+        default:
+            return 0;
+    }
+}
+
+static uint8_t alu_escalar(uint8_t funct3, bool sub_sra) {
+    switch (funct3) {
+        case 0: return sub_sra ? ALU_SUB : ALU_ADD;
+        case 1: return ALU_SLL;
+        case 2: return ALU_SLT;
+        case 3: return ALU_SLTU;
+        case 4: return ALU_XOR;
+        case 5: return sub_sra ? ALU_SRA : ALU_SRL;
+        case 6: return ALU_OR;
+        default: return ALU_AND;
+    }
+}
+
+static Instrucao decodificar(uint32_t in) {
+    Instrucao d;
+    std::memset(&d, 0, sizeof(d));
+    d.bits = in;
+    d.opcode = in & 0x7F;
+    d.rd = (in >> 7) & 0x1F;
+    d.funct3 = (in >> 12) & 0x7;
+    d.rs1 = (in >> 15) & 0x1F;
+    d.rs2 = (in >> 20) & 0x1F;
+    d.funct7 = (in >> 25) & 0x7F;
+    d.imm = gerar_imediato(in);
+
+    switch (d.opcode) {
+        case OP_R:
+            d.reg_write = true; d.usa_rs1 = d.usa_rs2 = true;
+            d.alu_ctrl = MODO_ESCALAR | alu_escalar(d.funct3, d.funct7 & 0x20);
+            break;
+        case OP_I:
+            d.reg_write = true; d.alu_src = true; d.usa_rs1 = true;
+            // Só srai usa funct7[5]; nos demais o bit faz parte do imediato
+            d.alu_ctrl = MODO_ESCALAR | alu_escalar(d.funct3, d.funct3 == 5 && (d.funct7 & 0x20));
+            break;
+        case OP_LOAD:
+            d.reg_write = true; d.mem_read = true; d.mem_to_reg = true;
+            d.alu_src = true; d.usa_rs1 = true;
+            d.alu_ctrl = ALU_ADD;
+            break;
+        case OP_STORE:
+            d.mem_write = true; d.alu_src = true; d.usa_rs1 = d.usa_rs2 = true;
+            d.alu_ctrl = ALU_ADD;
+            break;
+        case OP_BRANCH:
+            d.branch = true; d.usa_rs1 = d.usa_rs2 = true;
+            d.alu_ctrl = ALU_SUB;
+            break;
+        case OP_LUI:
+            d.reg_write = true; d.alu_src = true;
+            d.alu_ctrl = ALU_LUI;
+            break;
+        case OP_AUIPC:
+            d.reg_write = true; d.alu_src = true; d.auipc = true;
+            d.alu_ctrl = ALU_ADD;
+            break;
+        case OP_JAL:
+            d.reg_write = true; d.jal = true;
+            break;
+        case OP_JALR:
+            d.reg_write = true; d.jalr = true; d.usa_rs1 = true;
+            break;
+        case OP_VETOR:
+            d.reg_write = true; d.is_vector = true; d.usa_rs1 = d.usa_rs2 = true;
+            // Mesma tabela do alu_control.v: {funct7, funct3}
+            switch ((d.funct7 << 3) | d.funct3) {
+                case 0x0: d.alu_ctrl = MODO_4X8  | ALU_ADD; break;  // vadd.8
+                case 0x1: d.alu_ctrl = MODO_2X16 | ALU_ADD; break;  // vadd.16
+                case 0x2: d.alu_ctrl = MODO_4X8  | ALU_SUB; break;  // vsub.8
+                case 0x3: d.alu_ctrl = MODO_2X16 | ALU_SUB; break;  // vsub.16
+                case 0x4: d.alu_ctrl = MODO_4X8  | ALU_AND; break;  // vand.8
+                case 0x5: d.alu_ctrl = MODO_2X16 | ALU_AND; break;  // vand.16
+                case 0x6: d.alu_ctrl = MODO_4X8  | ALU_OR;  break;  // vor.8
+                case 0x7: d.alu_ctrl = MODO_2X16 | ALU_OR;  break;  // vor.16
+                case 0x8: d.alu_ctrl = MODO_4X8  | VOP_MUL; break;  // vmul.8
+                case 0x9: d.alu_ctrl = MODO_2X16 | VOP_MUL; break;  // vmul.16
+                case 0xA: d.alu_ctrl = MODO_4X8  | VOP_DOT; break;  // vdot.8
+                case 0xB: d.alu_ctrl = MODO_2X16 | VOP_DOT; break;  // vdot.16
+                default:  d.alu_ctrl = 0; break;
+            }
+            d.reads_rd = (d.funct7 == 1) && ((d.funct3 >> 1) == 1);
+            break;
+        case OP_MEM_PI:
+            d.reg_write = true; d.mem_read = true; d.mem_to_reg = true;
+            d.alu_src = true; d.usa_rs1 = true;
+            d.alu_ctrl = ALU_ADD;
+            if (d.funct3 == 3) {
+                // ld.par rd, imm(rs1): rd = M[rs1+imm], rd+1 = M[rs1+imm+4]
+                d.par = true;
+                d.reg_write2 = true; d.mem_to_reg2 = true;
+                d.rd2 = (d.rd + 1) & 0x1F;
+            } else {
+                // lw.pi rd, imm(rs1): rd = M[rs1], rs1 = rs1 + imm
+                d.pos_incremento = true;
+                d.reg_write2 = true;
+                d.rd2 = d.rs1;
+            }
+            break;
+        case OP_SW_PI:
+            // sw.pi rs2, imm(rs1): M[rs1] = rs2, rs1 = rs1 + imm
+            d.mem_write = true; d.alu_src = true; d.usa_rs1 = d.usa_rs2 = true;
+            d.alu_ctrl = ALU_ADD;
+            d.pos_incremento = true;
+            d.reg_write2 = true;
+            d.rd2 = d.rs1;
+            break;
+        case OP_SYSTEM:
+            d.parada = true;
+            break;
+        default:
+            break;  // NOP, como o default da control_unit
+    }
+    // x0 nunca é escrito
+    if (d.rd == 0) d.reg_write = false;
+    if (d.rd2 == 0) d.reg_write2 = false;
+    return d;
+}
+
+// --- ALU (alu.v) ---
+static inline uint32_t alu(uint32_t a, uint32_t b, uint32_t c, uint8_t ctrl) {
+    uint8_t op = ctrl & 0x0F;
+    switch (ctrl & 0x30) {
+        case MODO_ESCALAR:
+            switch (op) {
+                case ALU_ADD:  return a + b;
+                case ALU_SUB:  return a - b;
+                case ALU_AND:  return a & b;
+                case ALU_OR:   return a | b;
+                case ALU_XOR:  return a ^ b;
+                case ALU_SLL:  return a << (b & 31);
+                case ALU_SRL:  return a >> (b & 31);
+                case ALU_SRA:  return (uint32_t)((int32_t)a >> (b & 31));
+                case ALU_LUI:  return b;
+                case ALU_SLT:  return (int32_t)a < (int32_t)b;
+                case ALU_SLTU: return a < b;
+                default:       return 0;
+            }
+        case MODO_4X8: {
+            if (op == ALU_AND) return a & b;
+            if (op == ALU_OR) return a | b;
+            if (op == VOP_DOT) {
+                uint32_t r = c;
+                for (int s = 0; s < 32; s += 8)
+                    r += (uint32_t)((int32_t)(int8_t)(a >> s) * (int8_t)(b >> s));
+                return r;
+            }
+            uint32_t r = 0;
+            for (int s = 0; s < 32; s += 8) {
+                uint32_t x = (a >> s) & 0xFF, y = (b >> s) & 0xFF;
+                uint32_t v = (op == ALU_ADD) ? x + y : (op == ALU_SUB) ? x - y :
+                             (op == VOP_MUL) ? x * y : 0;
+                r |= (v & 0xFF) << s;
+            }
+            return r;
+        }
+        case MODO_2X16: {
+            if (op == ALU_AND) return a & b;
+            if (op == ALU_OR) return a | b;
+            if (op == VOP_DOT) {
+                return c + (uint32_t)((int32_t)(int16_t)a * (int16_t)b) +
+                           (uint32_t)((int32_t)(int16_t)(a >> 16) * (int16_t)(b >> 16));
+            }
+            uint32_t r = 0;
+            for (int s = 0; s < 32; s += 16) {
+                uint32_t x = (a >> s) & 0xFFFF, y = (b >> s) & 0xFFFF;
+                uint32_t v = (op == ALU_ADD) ? x + y : (op == ALU_SUB) ? x - y :
+                             (op == VOP_MUL) ? x * y : 0;
+                r |= (v & 0xFFFF) << s;
+            }
+            return r;
+        }
+        default:
+            return 0;
+    }
+}
+
+static inline bool desvio_tomado(uint8_t funct3, uint32_t a, uint32_t b) {
+    switch (funct3) {
+        case 0: return a == b;                       // beq
+        case 1: return a != b;                       // bne
+        case 4: return (int32_t)a < (int32_t)b;      // blt
+        case 5: return (int32_t)a >= (int32_t)b;     // bge
+        case 6: return a < b;                        // bltu
+        case 7: return a >= b;                       // bgeu
+        default: return false;
+    }
+}
+
+// --- CARREGAMENTO DE .hex ---
+// Aceita o formato da ROM/RAM do Digital ("v2.0 raw", palavras em hex
+// separadas por espaço, "N*valor" para repetições) e o formato de uma
+// instrução por linha com comentários '#' ou '//'.
+static std::vector<uint32_t> carregar_hex(const char* caminho) {
+    std::ifstream f(caminho);
+    if (!f) {
+        std::printf("[ERRO] Não foi possível abrir %s\n", caminho);
+        std::exit(1);
+    }
+    std::vector<uint32_t> palavras;
+    std::string linha;
+    while (std::getline(f, linha)) {
+        size_t c = linha.find('#');
+        if (c != std::string::npos) linha.erase(c);
+        c = linha.find("//");
+        if (c != std::string::npos) linha.erase(c);
+        if (linha.compare(0, 4, "v2.0") == 0) continue;
+
+        std::istringstream ss(linha);
+        std::string tok;
+        while (ss >> tok) {
+            long repet = 1;
+            size_t estrela = tok.find('*');
+            if (estrela != std::string::npos) {
+                repet = std::strtol(tok.substr(0, estrela).c_str(), nullptr, 10);
+                tok = tok.substr(estrela + 1);
+            }
+            char* fim;
+            unsigned long v = std::strtoul(tok.c_str(), &fim, 16);
+            if (*fim != '\0') {
+                std::printf("[ERRO] Palavra inválida em %s: '%s'\n", caminho, tok.c_str());
+                std::exit(1);
+            }
+            for (long r = 0; r < repet; r++) palavras.push_back((uint32_t)v);
+        }
+    }
+    return palavras;
+}
+
+// --- PREDITOR DE DESVIOS (branch_predictor.v) ---
+enum ModoPreditor { PRED_NENHUM, PRED_BIMODAL, PRED_GSHARE };
+
+static const char* nome_preditor(ModoPreditor m) {
+    return m == PRED_NENHUM ? "nenhum" : m == PRED_BIMODAL ? "bimodal" : "gshare";
+}
+
+class Preditor {
+public:
+    explicit Preditor(ModoPreditor modo) : modo_(modo) { reset(); }
+
+    void reset() {
+        for (int i = 0; i < (1 << BTB_BITS); i++) btb_[i] = {false, false, 0, 0};
+        for (int i = 0; i < (1 << PHT_BITS); i++) pht_[i] = 1;  // Fracamente não tomado
+        ghr_ = 0;
+    }
+
+    // Consulta em IF: só prevê tomado quando a BTB conhece o alvo
+    Predicao consultar(uint32_t pc) const {
+        Predicao p = {false, 0, indice(pc)};
+        if (modo_ == PRED_NENHUM) return p;
+        const EntradaBTB& e = btb_[(pc >> 2) & ((1 << BTB_BITS) - 1)];
+        if (e.valido && e.tag == (pc >> (BTB_BITS + 2))) {
+            p.taken = e.salto || (pht_[p.idx] & 2);
+            p.target = e.alvo;
+        }
+        return p;
+    }
+
+    // Atualização em EX com o resultado real
+    void atualizar(uint32_t pc, const Predicao& pred, bool condicional, bool taken, uint32_t alvo) {
+        if (modo_ == PRED_NENHUM) return;
+        if (condicional) {
+            uint8_t& c = pht_[pred.idx];
+            if (taken && c < 3) c++;
+            else if (!taken && c > 0) c--;
+            ghr_ = ((ghr_ << 1) | taken) & ((1 << PHT_BITS) - 1);
+        }
+        if (taken) {
+            EntradaBTB& e = btb_[(pc >> 2) & ((1 << BTB_BITS) - 1)];
+            e = {true, !condicional, pc >> (BTB_BITS + 2), alvo};
+        }
+    }
+
+private:
+    struct EntradaBTB {
+        bool valido;
+        bool salto;       // jal/jalr: sempre tomado quando acerta a BTB
+        uint32_t tag;
+        uint32_t alvo;
+    };
+
+    ModoPreditor modo_;
+    EntradaBTB btb_[1 << BTB_BITS];
+    uint8_t pht_[1 << PHT_BITS];
+    uint32_t ghr_;
+
+    uint32_t indice(uint32_t pc) const {
+        uint32_t i = (pc >> 2) & ((1 << PHT_BITS) - 1);
+        return (modo_ == PRED_GSHARE) ? i ^ ghr_ : i;
+    }
+};
+
+// --- SIMULADOR ---
+class Simulador {
+public:
+    Simulador(const std::vector<uint32_t>& programa, size_t ram_bytes, ModoPreditor modo)
+        : ram_(ram_bytes, 0), preditor_(modo) {
+        rom_.reserve(programa.size());
+        for (uint32_t w : programa) rom_.push_back(decodificar(w));
+        nop_ = decodificar(INSTR_NOP);
+        std::memset(regs_, 0, sizeof(regs_));
+        reset();
+    }
+
+    void carregar_dados(const std::vector<uint32_t>& dados) {
+        if (dados.size() * 4 > ram_.size()) {
+            std::printf("[ERRO] Dados (%zu bytes) maiores que a RAM (%zu bytes)\n",
+                        dados.size() * 4, ram_.size());
+            std::exit(1);
+        }
+        std::memcpy(ram_.data(), dados.data(), dados.size() * 4);
+    }
+
+    void reset() {
+        pc_ = 0;
+        if_id_ = {0, nullptr, {}};
+        id_ex_ = {0, 0, 0, 0, nullptr, {}};
+        ex_mem_ = {0, 0, 0, nullptr};
+        mem_wb_ = {0, 0, 0, nullptr};
+        parado_ = false;
+        preditor_.reset();
+        st_ = Estatisticas();
+    }
+
+    // Roda até ecall/ebreak em WB, até o pipeline esvaziar depois do fim
+    // da ROM, ou até max_ciclos
+    void executar(uint64_t max_ciclos, bool trace) {
+        while (!parado_ && st_.ciclos < max_ciclos) {
+            if (trace) imprimir_estagios();
+            ciclo();
+            if (pc_ >= rom_.size() * 4 && !if_id_.instr && !id_ex_.instr &&
+                !ex_mem_.instr && !mem_wb_.instr) {
+                break;
+            }
+        }
+    }
+
+    // Contagem estática das divergências de decodificação do Verilog
+    void contar_divergencias() {
+        for (const Instrucao& d : rom_) {
+            if (d.opcode == OP_I && d.funct3 != 5 && (d.funct7 & 0x20)) st_.divergencias_addi++;
+            if ((d.opcode == OP_R || d.opcode == OP_I) && (d.funct3 == 2 || d.funct3 == 3))
+                st_.divergencias_slt++;
+        }
+    }
+
+    const Estatisticas& estatisticas() const { return st_; }
+    uint32_t reg(int i) const { return regs_[i]; }
+    bool parou_por_ecall() const { return parado_; }
+
+    uint32_t ler_palavra(uint32_t addr) const {
+        uint32_t v;
+        std::memcpy(&v, &ram_[addr], 4);
+        return v;
+    }
+    size_t tamanho_ram() const { return ram_.size(); }
+
+private:
+    std::vector<Instrucao> rom_;
+    std::vector<uint8_t> ram_;
+    Instrucao nop_;
+    uint32_t regs_[32];
+    uint32_t pc_;
+    IF_ID if_id_;
+    ID_EX id_ex_;
+    EX_MEM ex_mem_;
+    MEM_WB mem_wb_;
+    bool parado_;
+    Preditor preditor_;
+    Estatisticas st_;
+
+    void verificar_endereco(uint32_t addr, uint32_t bytes) const {
+        if ((uint64_t)addr + bytes > ram_.size()) {
+            std::printf("[ERRO] Acesso fora da RAM: endereço 0x%08x (ciclo %llu)\n",
+                        addr, (unsigned long long)st_.ciclos);
+            std::exit(1);
+        }
+    }
+
+    uint32_t carregar(uint32_t addr, uint8_t funct3) {
+        switch (funct3) {
+            case 0: verificar_endereco(addr, 1); return (uint32_t)(int8_t)ram_[addr];
+            case 4: verificar_endereco(addr, 1); return ram_[addr];
+            case 1: {
+                verificar_endereco(addr, 2);
+                int16_t h; std::memcpy(&h, &ram_[addr], 2); return (uint32_t)(int32_t)h;
+            }
+            case 5: {
+                verificar_endereco(addr, 2);
+                uint16_t h; std::memcpy(&h, &ram_[addr], 2); return h;
+            }
+            default: {
+                verificar_endereco(addr, 4);
+                uint32_t w; std::memcpy(&w, &ram_[addr], 4); return w;
+            }
+        }
+    }
+
+    void armazenar(uint32_t addr, uint32_t v, uint8_t funct3) {
+        uint32_t bytes = (funct3 == 0) ? 1 : (funct3 == 1) ? 2 : 4;
+        verificar_endereco(addr, bytes);
+        std::memcpy(&ram_[addr], &v, bytes);
+    }
+
+    // Um ciclo de clock. Todos os estágios leem o estado atual dos
+    // registradores de pipeline e escrevem no próximo estado, que é
+    // copiado no fim (equivalente ao posedge clk).
+    void ciclo() {
+        st_.ciclos++;
+
+        // ===== WB =====
+        uint32_t wb_valor = 0, wb_valor2 = 0;
+        bool wb_escreve = false, wb_escreve2 = false;
+        uint8_t wb_rd = 0, wb_rd2 = 0;
+        if (const Instrucao* w = mem_wb_.instr) {
+            if (w->parada) {
+                parado_ = true;
+                return;
+            }
+            wb_valor = w->mem_to_reg ? mem_wb_.mem_data : mem_wb_.alu_result;
+            wb_valor2 = w->mem_to_reg2 ? mem_wb_.mem_data_hi : mem_wb_.alu_result;
+            if (w->reg_write) {
+                wb_escreve = true;
+                wb_rd = w->rd;
+            }
+            if (w->reg_write2) {
+                wb_escreve2 = true;
+                wb_rd2 = w->rd2;
+            }
+            st_.instrucoes++;
+        }
+
+        // ===== MEM =====
+        MEM_WB prox_mem_wb = {ex_mem_.alu_result, 0, 0, ex_mem_.instr};
+        if (const Instrucao* m = ex_mem_.instr) {
+            if (m->mem_read) {
+                if (m->par) {
+                    prox_mem_wb.mem_data = carregar(ex_mem_.mem_addr, 2);
+                    prox_mem_wb.mem_data_hi = carregar(ex_mem_.mem_addr + 4, 2);
+                    st_.bytes_mem += 8;
+                } else {
+                    prox_mem_wb.mem_data = carregar(ex_mem_.mem_addr, m->funct3);
+                    st_.bytes_mem += 1u << (m->funct3 & 3);
+                }
+                st_.loads++;
+            } else if (m->mem_write) {
+                armazenar(ex_mem_.mem_addr, ex_mem_.write_data, m->funct3);
+                st_.bytes_mem += 1u << (m->funct3 & 3);
+                st_.stores++;
+            }
+        }
+
+        // ===== EX =====
+        EX_MEM prox_ex_mem = {0, 0, 0, id_ex_.instr};
+        bool mispredict = false;    // branch_check: próximo PC real != previsto
+        uint32_t pc_correto = 0;
+        if (const Instrucao* e = id_ex_.instr) {
+            // forwarding_unit: MEM tem prioridade sobre WB e, em cada estágio,
+            // a porta 1 sobre a porta 2. De MEM só sai alu_result (base do
+            // pós-incremento); dado de load em MEM é coberto pelo hazard_unit.
+            // O hardware compara os campos crus; só contamos operandos usados
+            const Instrucao* m = ex_mem_.instr;
+            const Instrucao* w = mem_wb_.instr;
+            auto encaminhar = [&](uint8_t r, uint32_t v, bool usado) -> uint32_t {
+                if (!r) return v;
+                if (m && ((m->reg_write && m->rd == r) || (m->reg_write2 && m->rd2 == r))) {
+                    st_.fwd_mem += usado;
+                    return ex_mem_.alu_result;
+                }
+                if (w && w->reg_write && w->rd == r) {
+                    st_.fwd_wb += usado;
+                    return wb_valor;
+                }
+                if (w && w->reg_write2 && w->rd2 == r) {
+                    st_.fwd_wb += usado;
+                    return wb_valor2;
+                }
+                return v;
+            };
+            uint32_t a = encaminhar(e->rs1, id_ex_.read_data1, e->usa_rs1);
+            uint32_t b = encaminhar(e->rs2, id_ex_.read_data2, e->usa_rs2);
+            // forwardC: acumulador do vdot (rd lido como fonte)
+            uint32_t c = e->reads_rd ? encaminhar(e->rd, id_ex_.read_data3, true) : 0;
+
+            bool taken = false;
+            uint32_t alvo = 0;
+            if (e->branch) {
+                st_.desvios++;
+                taken = desvio_tomado(e->funct3, a, b);
+                alvo = id_ex_.pc + e->imm;
+                st_.desvios_tomados += taken;
+                preditor_.atualizar(id_ex_.pc, id_ex_.pred, true, taken, alvo);
+            } else if (e->jal || e->jalr) {
+                st_.saltos++;
+                taken = true;
+                alvo = e->jal ? id_ex_.pc + e->imm : (a + e->imm) & ~1u;
+                prox_ex_mem.alu_result = id_ex_.pc + 4;
+                preditor_.atualizar(id_ex_.pc, id_ex_.pred, false, true, alvo);
+            } else {
+                uint32_t op_a = e->auipc ? id_ex_.pc : a;
+                uint32_t op_b = e->alu_src ? (uint32_t)e->imm : b;
+                prox_ex_mem.alu_result = alu(op_a, op_b, c, e->alu_ctrl);
+                if (e->is_vector) st_.vetoriais++;
+            }
+            prox_ex_mem.write_data = b;  // Dado do store já com forwarding
+            prox_ex_mem.mem_addr = e->pos_incremento ? a : prox_ex_mem.alu_result;
+
+            // Qualquer instrução pode ter sido prevista como tomada (alias na
+            // BTB); a comparação é sempre entre o próximo PC previsto e o real
+            uint32_t previsto = id_ex_.pred.taken ? id_ex_.pred.target : id_ex_.pc + 4;
+            pc_correto = taken ? alvo : id_ex_.pc + 4;
+            mispredict = (previsto != pc_correto);
+        }
+
+        // ===== Escrita no banco (WB) =====
+        // Feita antes da leitura de ID: banco "escreve antes de ler"
+        // Mesmo registrador nas duas portas (lw.pi com rd == rs1): vence a porta 1
+        if (wb_escreve2) regs_[wb_rd2] = wb_valor2;
+        if (wb_escreve) regs_[wb_rd] = wb_valor;
+
+        // ===== ID + hazard_unit =====
+        ID_EX prox_id_ex = {0, 0, 0, 0, nullptr, {}};
+        bool stall = false;
+        if (const Instrucao* d = if_id_.instr) {
+            const Instrucao* e = id_ex_.instr;
+            // Campos de ID comparados pelo hazard_unit (crus) e os realmente lidos
+            auto compara = [d](uint8_t r) {
+                return r != 0 && (r == d->rs1 || r == d->rs2 || (d->reads_rd && r == d->rd));
+            };
+            auto le = [d](uint8_t r) {
+                return r != 0 && ((d->usa_rs1 && r == d->rs1) || (d->usa_rs2 && r == d->rs2) ||
+                                  (d->reads_rd && r == d->rd));
+            };
+            // Destinos que recebem dado da memória: rd do load e rd+1 do ld.par
+            uint8_t load_rd = (e && e->mem_read) ? e->rd : 0;
+            uint8_t load_rd2 = (e && e->mem_read && e->mem_to_reg2) ? e->rd2 : 0;
+            if (compara(load_rd) || compara(load_rd2)) {
+                stall = true;
+                if (le(load_rd) || le(load_rd2)) st_.stalls_load_use++;
+                else st_.stalls_falsos++;
+            } else {
+                if ((wb_escreve && le(wb_rd)) || (wb_escreve2 && le(wb_rd2))) {
+                    st_.leitura_wb_id++;
+                }
+                prox_id_ex.pc = if_id_.pc;
+                prox_id_ex.read_data1 = regs_[d->rs1];
+                prox_id_ex.read_data2 = regs_[d->rs2];
+                prox_id_ex.read_data3 = regs_[d->rd];
+                prox_id_ex.instr = d;
+                prox_id_ex.pred = if_id_.pred;
+            }
+        }
+
+        // ===== pipeline_ctrl =====
+        IF_ID prox_if_id = if_id_;
+        uint32_t prox_pc = pc_;
+        if (stall) {
+            // pc_write = 0, if_id_write = 0, id_ex_flush = 1
+            prox_id_ex = {0, 0, 0, 0, nullptr, {}};
+        } else if (mispredict) {
+            // if_id_flush = 1, id_ex_flush = 1, pc_recover = 1
+            st_.flushes++;
+            st_.descartadas += (if_id_.instr != nullptr) + (prox_id_ex.instr != nullptr);
+            prox_if_id = {0, nullptr, {}};
+            prox_id_ex = {0, 0, 0, 0, nullptr, {}};
+            prox_pc = pc_correto;
+        } else {
+            // ===== IF + next_pc =====
+            size_t idx = pc_ >> 2;
+            prox_if_id.pc = pc_;
+            prox_if_id.instr = (idx < rom_.size()) ? &rom_[idx] : nullptr;
+            prox_if_id.pred = preditor_.consultar(pc_);
+            prox_pc = prox_if_id.pred.taken ? prox_if_id.pred.target : pc_ + 4;
+        }
+
+        // ===== posedge clk =====
+        pc_ = prox_pc;
+        if_id_ = prox_if_id;
+        id_ex_ = prox_id_ex;
+        ex_mem_ = prox_ex_mem;
+        mem_wb_ = prox_mem_wb;
+    }
+
+    void imprimir_estagios() const {
+        auto fmt = [](const Instrucao* i) { return i ? i->bits : 0u; };
+        std::printf("%8llu  PC=%08x  IF/ID=%08x  ID/EX=%08x  EX/MEM=%08x  MEM/WB=%08x\n",
+                    (unsigned long long)st_.ciclos, pc_, fmt(if_id_.instr), fmt(id_ex_.instr),
+                    fmt(ex_mem_.instr), fmt(mem_wb_.instr));
+    }
+
+};
+
+// --- RELATÓRIO ---
+static void imprimir_relatorio(const Simulador& sim, ModoPreditor modo, double segundos) {
+    const Estatisticas& s = sim.estatisticas();
+    double cpi = s.instrucoes ? (double)s.ciclos / s.instrucoes : 0.0;
+    uint64_t controle = s.desvios + s.saltos;
+
+    std::printf("\n==========================================================\n");
+    std::printf("           SIMULADOR PIPELINE RISC-V (5 ESTÁGIOS)\n");
+    std::printf("==========================================================\n");
+    std::printf("Término:                 %s\n", sim.parou_por_ecall() ? "ecall/ebreak em WB" : "fim do programa / limite");
+    std::printf("Ciclos:                  %llu\n", (unsigned long long)s.ciclos);
+    std::printf("Instruções retiradas:    %llu\n", (unsigned long long)s.instrucoes);
+    std::printf("CPI:                     %.3f\n", cpi);
+    std::printf("\n--- Hazards ---\n");
+    std::printf("Stalls load-use:         %llu\n", (unsigned long long)s.stalls_load_use);
+    std::printf("Stalls falsos (rs2 cru): %llu\n", (unsigned long long)s.stalls_falsos);
+    std::printf("Preditor:                %s (BTB %d, PHT %d)\n",
+                nome_preditor(modo), 1 << BTB_BITS, 1 << PHT_BITS);
+    std::printf("Flushes (pred. errada):  %llu (%llu instruções descartadas)\n",
+                (unsigned long long)s.flushes, (unsigned long long)s.descartadas);
+    std::printf("Desvios condicionais:    %llu (%llu tomados)\n",
+                (unsigned long long)s.desvios, (unsigned long long)s.desvios_tomados);
+    std::printf("jal/jalr:                %llu\n", (unsigned long long)s.saltos);
+    if (controle > 0) {
+        std::printf("Acerto da predição:      %.1f%%\n",
+                    100.0 * (double)(controle - s.flushes) / controle);
+    }
+    std::printf("Forwarding EX/MEM:       %llu\n", (unsigned long long)s.fwd_mem);
+    std::printf("Forwarding MEM/WB:       %llu\n", (unsigned long long)s.fwd_wb);
+    std::printf("\n--- Mistura ---\n");
+    std::printf("Loads / stores:          %llu / %llu\n",
+                (unsigned long long)s.loads, (unsigned long long)s.stores);
+    std::printf("Bytes de memória:        %llu (%.3f bytes/ciclo)\n", (unsigned long long)s.bytes_mem,
+                s.ciclos ? (double)s.bytes_mem / s.ciclos : 0.0);
+    std::printf("Vetoriais (0100111):     %llu\n", (unsigned long long)s.vetoriais);
+    std::printf("\n--- Diferenças em relação aos módulos Verilog ---\n");
+    std::printf("Leituras WB->ID no mesmo ciclo:     %llu (regfile.v precisa escrever antes de ler)\n",
+                (unsigned long long)s.leitura_wb_id);
+    std::printf("Tipo I com bit 30 = 1 (na ROM):     %llu (alu_control.v faria SUB)\n",
+                (unsigned long long)s.divergencias_addi);
+    std::printf("slt/sltu/slti/sltiu (na ROM):       %llu (alu_control.v faria SUB)\n",
+                (unsigned long long)s.divergencias_slt);
+    std::printf("\n--- Velocidade do simulador ---\n");
+    std::printf("Tempo:                   %.3f s\n", segundos);
+    if (segundos > 0) {
+        std::printf("Ciclos/s:                %.1f M\n", s.ciclos / segundos * 1e-6);
+        std::printf("MIPS simulados:          %.1f\n", s.instrucoes / segundos * 1e-6);
+    }
+}
+
+// --- COMPARAÇÃO DE PREDITORES ---
+// Roda o mesmo programa com cada preditor e mostra o CPI lado a lado;
+// "nenhum" é o pipeline antigo (sempre não tomado, flush em todo desvio tomado)
+static void comparar_preditores(const std::vector<uint32_t>& rom, const std::vector<uint32_t>& dados,
+                                size_t ram_bytes, uint64_t max_ciclos) {
+    const ModoPreditor modos[] = {PRED_NENHUM, PRED_BIMODAL, PRED_GSHARE};
+    uint64_t ciclos_base = 0;
+
+    std::printf("\n╔══════════╦══════════════╦══════════════╦═════════╦══════════╦═══════════╦══════════╗\n");
+    std::printf("║ Preditor ║ Ciclos       ║ Instruções   ║ CPI     ║ Flushes  ║ Acerto    ║ Speedup  ║\n");
+    std::printf("╠══════════╬══════════════╬══════════════╬═════════╬══════════╬═══════════╬══════════╣\n");
+    for (ModoPreditor m : modos) {
+        Simulador sim(rom, ram_bytes, m);
+        if (!dados.empty()) sim.carregar_dados(dados);
+        sim.executar(max_ciclos, false);
+        const Estatisticas& s = sim.estatisticas();
+        if (m == PRED_NENHUM) ciclos_base = s.ciclos;
+        uint64_t controle = s.desvios + s.saltos;
+        double acerto = controle ? 100.0 * (double)(controle - s.flushes) / controle : 100.0;
+        std::printf("║ %-8s ║ %12llu ║ %12llu ║ %7.3f ║ %8llu ║ %8.1f%% ║ %7.2fx ║\n",
+                    nome_preditor(m), (unsigned long long)s.ciclos, (unsigned long long)s.instrucoes,
+                    s.instrucoes ? (double)s.ciclos / s.instrucoes : 0.0,
+                    (unsigned long long)s.flushes, acerto,
+                    s.ciclos ? (double)ciclos_base / s.ciclos : 0.0);
+    }
+    std::printf("╚══════════╩══════════════╩══════════════╩═════════╩══════════╩═══════════╩══════════╝\n");
+    std::printf("  BTB %d entradas, PHT %d contadores de 2 bits, penalidade 2 ciclos por predição errada\n",
+                1 << BTB_BITS, 1 << PHT_BITS);
+}
+
+static void uso(const char* prog) {
+    std::printf("Uso: %s programa.hex [-d dados.hex] [-m KB] [-c max_ciclos] [-p preditor] [-P]\n"
+                "       [-r] [-x endereco:palavras] [-t]\n", prog);
+    std::printf("  -d  conteúdo inicial da RAM (palavras a partir do endereço 0)\n");
+    std::printf("  -m  tamanho da RAM em KB (padrão %d)\n", RAM_KB_PADRAO);
+    std::printf("  -c  limite de ciclos\n");
+    std::printf("  -p  preditor de desvios: nenhum, bimodal ou gshare (padrão)\n");
+    std::printf("  -P  compara CPI dos três preditores no mesmo programa\n");
+    std::printf("  -r  imprime os registradores diferentes de zero no fim\n");
+    std::printf("  -x  imprime palavras da RAM (endereço em hex)\n");
+    std::printf("  -t  trace ciclo a ciclo dos registradores de pipeline\n");
+}
+
+// --- FUNÇÃO PRINCIPAL ---
+int main(int argc, char** argv) {
+    const char* programa = nullptr;
+    const char* dados = nullptr;
+    size_t ram_kb = RAM_KB_PADRAO;
+    uint64_t max_ciclos = MAX_CICLOS_PADRAO;
+    bool mostrar_regs = false, trace = false, comparar = false;
+    ModoPreditor modo = PRED_GSHARE;
+    uint32_t dump_inicio = 0, dump_palavras = 0;
+
+    for (int a = 1; a < argc; a++) {
+        if (!std::strcmp(argv[a], "-d") && a + 1 < argc) dados = argv[++a];
+        else if (!std::strcmp(argv[a], "-m") && a + 1 < argc) ram_kb = std::strtoul(argv[++a], nullptr, 10);
+        else if (!std::strcmp(argv[a], "-c") && a + 1 < argc) max_ciclos = std::strtoull(argv[++a], nullptr, 10);
+        else if (!std::strcmp(argv[a], "-p") && a + 1 < argc) {
+            const char* m = argv[++a];
+            if (!std::strcmp(m, "nenhum")) modo = PRED_NENHUM;
+            else if (!std::strcmp(m, "bimodal")) modo = PRED_BIMODAL;
+            else if (!std::strcmp(m, "gshare")) modo = PRED_GSHARE;
+            else { uso(argv[0]); return 1; }
+        }
+        else if (!std::strcmp(argv[a], "-P")) comparar = true;
+        else if (!std::strcmp(argv[a], "-r")) mostrar_regs = true;
+        else if (!std::strcmp(argv[a], "-t")) trace = true;
+        else if (!std::strcmp(argv[a], "-x") && a + 1 < argc) {
+            char* sep;
+            dump_inicio = std::strtoul(argv[++a], &sep, 16);
+            dump_palavras = (*sep == ':') ? std::strtoul(sep + 1, nullptr, 10) : 1;
+        }
+        else if (argv[a][0] != '-' && !programa) programa = argv[a];
+        else { uso(argv[0]); return 1; }
+    }
+    if (!programa) { uso(argv[0]); return 1; }
+
+    std::vector<uint32_t> rom = carregar_hex(programa);
+    if (rom.empty()) {
+        std::printf("[ERRO] %s não tem instruções\n", programa);
+        return 1;
+    }
+
+    std::vector<uint32_t> ram_inicial;
+    if (dados) ram_inicial = carregar_hex(dados);
+
+    if (comparar) {
+        comparar_preditores(rom, ram_inicial, ram_kb * 1024, max_ciclos);
+        return 0;
+    }
+
+    Simulador sim(rom, ram_kb * 1024, modo);
+    if (dados) sim.carregar_dados(ram_inicial);
+    sim.contar_divergencias();
+
+    auto t0 = std::chrono::steady_clock::now();
+    sim.executar(max_ciclos, trace);
+    auto t1 = std::chrono::steady_clock::now();
+    double segundos = std::chrono::duration<double>(t1 - t0).count();
+
+    imprimir_relatorio(sim, modo, segundos);
+
+    if (mostrar_regs) {
+        std::printf("\n--- Registradores (≠ 0) ---\n");
+        for (int i = 1; i < 32; i++) {
+            if (sim.reg(i)) std::printf("x%-2d = 0x%08x (%d)\n", i, sim.reg(i), (int32_t)sim.reg(i));
+        }
+    }
+    if (dump_palavras) {
+        std::printf("\n--- RAM a partir de 0x%08x ---\n", dump_inicio);
+        for (uint32_t p = 0; p < dump_palavras; p++) {
+            uint32_t addr = dump_inicio + 4 * p;
+            if (addr + 4 > sim.tamanho_ram()) break;
+            uint32_t v = sim.ler_palavra(addr);
+            std::printf("[0x%08x] = 0x%08x (%d)\n", addr, v, (int32_t)v);
+        }
+    }
+    return 0;
+}